@@ -0,0 +1,25 @@
+#ifndef _BENCHMARK_HPP_
+#define _BENCHMARK_HPP_
+
+#include <stdint.h>
+
+/**
+ * @brief On-target benchmarks measured with the DWT cycle counter, results are printed to the console.
+ */
+
+/// @brief Core cycles from reset to `main()`, stored by `reset_handler`.
+extern "C" uint32_t boot_cycles;
+
+/// @brief Prints cycles spent by startup code before `main()`.
+void benchmark_boot();
+
+/// @brief Runs CoreMark-style workload with ART accelerator disabled and enabled, leaves ART enabled.
+void benchmark_art();
+
+/// @brief Measures interrupt entry latency with vector table and handler in FLASH, then in SRAM.
+void benchmark_irq_entry();
+
+/// @brief Measures `SpiPolled` burst throughput on SPI1 for every baud rate divider.
+void benchmark_spi_polled();
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef _BOARD_HPP_
+#define _BOARD_HPP_
+
+#include "clock_config.hpp"
+
+/**
+ * @brief NUCLEO-F411RE clock tree: 8Mhz HSE from ST-LINK (bypass) to 100Mhz SYSCLK.
+ */
+using SystemClock = rcc::ClockConfig<8000000UL, 100000000UL>;
+
+/**
+ * @brief Low power profile for idle phases, 16Mhz SYSCLK with 0 wait states and regulator scale 3.
+ */
+using IdleClock = rcc::ClockConfig<8000000UL, 16000000UL>;
+
+#endif
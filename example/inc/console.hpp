@@ -0,0 +1,17 @@
+#ifndef _CONSOLE_HPP_
+#define _CONSOLE_HPP_
+
+#include "usart_log.hpp"
+#include "board.hpp"
+
+/**
+ * @brief Console output on USART2 (PA2 TX), routed to ST-LINK virtual COM port on NUCLEO-F411RE.
+ *
+ * `printf` output is copied into the ring by `_write()` and sent by DMA1 stream 6.
+ */
+using Console = UsartLog<usart::Peripherals::Usart2, 1024, usart::OverflowPolicy::Drop>;
+
+/// @brief Configures PA2, USART2 at 115200 baud from `SystemClock` APB1 and the TX DMA interrupt.
+void console_init();
+
+#endif
@@ -0,0 +1,234 @@
+#include "benchmark.hpp"
+#include "core_regs.hpp"
+#include "flash_regs.hpp"
+#include "clock.hpp"
+#include "clock_gating.hpp"
+#include "spi_polled.hpp"
+#include "ramfunc.hpp"
+
+#include "stm32f4xx.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+extern "C" uint32_t __ram_vector_start__[];
+extern uint32_t isr_vector[];
+
+namespace
+{
+    constexpr uint32_t MATRIX_SIZE = 8;
+    constexpr uint32_t ITERATIONS  = 20;
+
+    int16_t matrix_a[MATRIX_SIZE][MATRIX_SIZE];
+    int16_t matrix_b[MATRIX_SIZE][MATRIX_SIZE];
+    int32_t matrix_c[MATRIX_SIZE][MATRIX_SIZE];
+
+    const char state_input[] = "5012,1.25e3,-42,0x1F,+7,3.14159,abc,1e-5,-0.5,1200";
+
+    // CoreMark kernels in small: matrix multiply, state machine over text and CRC over the results
+    uint16_t crc16(uint16_t crc, uint32_t data)
+    {
+        for (uint32_t bit = 0; bit < 32; ++bit)
+        {
+            const bool mix = ((crc ^ data) & 1U) != 0;
+            crc = static_cast<uint16_t>(mix ? ((crc >> 1) ^ 0xA001U) : (crc >> 1));
+            data >>= 1;
+        }
+        return crc;
+    }
+
+    uint32_t matrix_kernel()
+    {
+        for (uint32_t i = 0; i < MATRIX_SIZE; ++i)
+        {
+            for (uint32_t j = 0; j < MATRIX_SIZE; ++j)
+            {
+                int32_t sum = 0;
+                for (uint32_t k = 0; k < MATRIX_SIZE; ++k)
+                    sum += matrix_a[i][k] * matrix_b[k][j];
+                matrix_c[i][j] = sum;
+            }
+        }
+
+        uint32_t result = 0;
+        for (uint32_t i = 0; i < MATRIX_SIZE; ++i)
+            result += static_cast<uint32_t>(matrix_c[i][i]);
+        return result;
+    }
+
+    uint32_t state_kernel()
+    {
+        enum class State : uint8_t { Start, Int, Frac, Exp, Hex, Invalid };
+        uint32_t counts[6]{};
+        State state = State::Start;
+
+        for (const char* c = state_input; *c; ++c)
+        {
+            if (*c == ',')
+            {
+                ++counts[static_cast<uint8_t>(state)];
+                state = State::Start;
+                continue;
+            }
+
+            switch (state)
+            {
+                case State::Start:
+                    state = (*c >= '0' && *c <= '9') || *c == '+' || *c == '-' ? State::Int : State::Invalid;
+                    break;
+                case State::Int:
+                    if (*c == '.')
+                        state = State::Frac;
+                    else if (*c == 'x')
+                        state = State::Hex;
+                    else if (*c == 'e')
+                        state = State::Exp;
+                    else if (*c < '0' || *c > '9')
+                        state = State::Invalid;
+                    break;
+                case State::Frac:
+                    if (*c == 'e')
+                        state = State::Exp;
+                    else if (*c < '0' || *c > '9')
+                        state = State::Invalid;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        uint32_t result = 0;
+        for (uint32_t i = 0; i < 6; ++i)
+            result = result * 7 + counts[i];
+        return result;
+    }
+
+    // EXTI1 is unused by the example, its vector is borrowed for the measurement
+    constexpr IRQn_Type BENCH_IRQ = EXTI1_IRQn;
+    constexpr uint32_t BENCH_VECTOR = 16U + static_cast<uint32_t>(BENCH_IRQ);
+
+    volatile uint32_t irq_entry_cycles;
+
+    HAL_RAMFUNC void ram_bench_handler(void)
+    {
+        irq_entry_cycles = CycleCounter::now();
+    }
+
+    uint32_t measure_irq_entry(const uint32_t* table)
+    {
+        VectorTable::relocate(table);
+        __DSB();
+
+        // Caches are reset, so the FLASH path pays wait states for vector and handler fetch
+        Flash::enable_art();
+
+        const uint32_t start = CycleCounter::now();
+        NVIC_SetPendingIRQ(BENCH_IRQ);
+        __DSB();
+        __ISB();
+        return irq_entry_cycles - start;
+    }
+
+    // SPI1 runs as master without pins, the shift register clocks regardless of MISO/MOSI routing
+    using BenchSpi = SpiRegs<spi::Peripherals::Spi_1>;
+    constexpr uint32_t SPI_BENCH_LEN = 64;
+
+    uint8_t spi_tx[SPI_BENCH_LEN];
+    uint8_t spi_rx[SPI_BENCH_LEN];
+
+    uint32_t workload()
+    {
+        uint16_t crc = 0;
+        for (uint32_t i = 0; i < ITERATIONS; ++i)
+        {
+            matrix_a[i % MATRIX_SIZE][(i * 3) % MATRIX_SIZE] += static_cast<int16_t>(i);
+            crc = crc16(crc, matrix_kernel());
+            crc = crc16(crc, state_kernel());
+        }
+        return crc;
+    }
+}
+
+void benchmark_boot()
+{
+    printf("Boot: %lu cycles from reset to main()\n", static_cast<unsigned long>(boot_cycles));
+}
+
+void benchmark_art()
+{
+    for (uint32_t i = 0; i < MATRIX_SIZE; ++i)
+    {
+        for (uint32_t j = 0; j < MATRIX_SIZE; ++j)
+        {
+            matrix_a[i][j] = static_cast<int16_t>(i * MATRIX_SIZE + j);
+            matrix_b[i][j] = static_cast<int16_t>(j - i);
+        }
+    }
+
+    CycleCounter::enable();
+
+    uint32_t crc = 0;
+    Flash::disable_art();
+    const uint32_t cycles_off = CycleCounter::measure([&crc] { crc = workload(); });
+
+    Flash::enable_art();
+    const uint32_t cycles_on = CycleCounter::measure([&crc] { crc = workload(); });
+
+    printf("ART off: %lu cycles, ART on: %lu cycles (crc %04lx)\n",
+           static_cast<unsigned long>(cycles_off), static_cast<unsigned long>(cycles_on), static_cast<unsigned long>(crc));
+}
+
+// Overrides the weak default, FLASH resident handler used through the FLASH vector table
+void exti1_handler(void)
+{
+    irq_entry_cycles = CycleCounter::now();
+}
+
+void benchmark_irq_entry()
+{
+    CycleCounter::enable();
+    NVIC_EnableIRQ(BENCH_IRQ);
+
+    const uint32_t cycles_flash = measure_irq_entry(isr_vector);
+
+    const uint32_t flash_vector = __ram_vector_start__[BENCH_VECTOR];
+    __ram_vector_start__[BENCH_VECTOR] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&ram_bench_handler));
+    const uint32_t cycles_ram = measure_irq_entry(__ram_vector_start__);
+    __ram_vector_start__[BENCH_VECTOR] = flash_vector;
+
+    NVIC_DisableIRQ(BENCH_IRQ);
+    printf("IRQ entry: FLASH %lu cycles, SRAM %lu cycles\n", static_cast<unsigned long>(cycles_flash), static_cast<unsigned long>(cycles_ram));
+}
+
+void benchmark_spi_polled()
+{
+    for (uint32_t i = 0; i < SPI_BENCH_LEN; ++i)
+        spi_tx[i] = static_cast<uint8_t>(i);
+
+    CycleCounter::enable();
+    ClockGating::acquire<BenchSpi>();
+
+    const rcc::Frequencies freq = Clock::frequencies();
+    for (uint32_t div = 0; div < 8; ++div)
+    {
+        const spi::BaudRateControl baud = static_cast<spi::BaudRateControl>(div);
+        BenchSpi::ControlReg1::write(spi::MasterSelectMask(spi::MasterSelection::Master) | spi::SlaveMngMask(spi::SlaveMng::Software)
+                                   | spi::InternSlaveSelMask(spi::InternSlaveSelect::Deselect) | spi::BaudRateCtrlMask(baud));
+        BenchSpi::ControlReg1::set(spi::SpiEnableMask(true));
+
+        StatusCode status = StatusCode::Ok;
+        const uint32_t cycles = CycleCounter::measure([&status] { status = SpiPolled<spi::Peripherals::Spi_1>::transfer(spi_tx, spi_rx, SPI_BENCH_LEN); });
+        // Bus limit: 8 SCK periods of (2 << div) APB2 cycles per byte
+        const uint32_t wire_cycles = SPI_BENCH_LEN * 8U * (2U << div) * (freq.sysclk_hz / freq.apb2_hz);
+        const uint32_t kbyte_s = static_cast<uint32_t>(static_cast<uint64_t>(SPI_BENCH_LEN) * freq.sysclk_hz / cycles / 1000U);
+
+        printf("SPI polled /%lu: %lu cycles for %lu bytes, %lu kB/s, %lu%% of bus limit%s\n",
+               static_cast<unsigned long>(2U << div), static_cast<unsigned long>(cycles), static_cast<unsigned long>(SPI_BENCH_LEN),
+               static_cast<unsigned long>(kbyte_s), static_cast<unsigned long>(100ULL * wire_cycles / cycles),
+               (status == StatusCode::Ok) ? "" : " (error)");
+
+        BenchSpi::ControlReg1::clear(spi::SpiEnableMask(true));
+    }
+
+    ClockGating::release<BenchSpi>();
+}
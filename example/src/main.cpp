@@ -16,13 +16,19 @@
 #include "flash_regs.hpp"
 #include "pwr_regs.hpp"
 #include "rcc_regs.hpp"
+#include "clock.hpp"
+#include "clock_gating.hpp"
 #include "gpio_regs.hpp"
+#include "board.hpp"
+#include "console.hpp"
+#include "benchmark.hpp"
 
 #include "system_stm32f4xx.h"
 
 #include <stdint.h>
+#include <stdio.h>
 
-// Init system clock to 96Mhz
+// Init system clock to 100Mhz, every factor is computed at compile time by SystemClock
 void system_init(void)
 {
     // Config input source clock (be aware that HSE bypass is enabled in this example, you maybe not need it enabled)
@@ -32,51 +38,52 @@ void system_init(void)
     // Enable power interface clock
     ResetClockCtrlRegs::Apb1EnableReg::set(rcc::PowerEnableMask());
 
-    // Set voltage scaling to support our freq of 96Mhz
-    PowerCtrlRegs::ControlReg::set(pwr::VoltageScalingOutSelMask(pwr::VoltageScalingOutSel::Scale_1));
-    // Config Flash register to wait state 3 as described in reference manual (this is required otherwise it will not work properly)
-    FlashRegs::AccessControlReg::set(flash::LatencyMask(flash::Latency::WaitState_3));
-
-    // Configure PLL
-    ResetClockCtrlRegs::PllConfigReg::clear(rcc::PllMMask() | rcc::PllNMask() | rcc::PllPMask() | rcc::PllQMask() | rcc::PllSrcMask());
-    ResetClockCtrlRegs::PllConfigReg::set(rcc::PllMMask(4) | rcc::PllNMask(192) | rcc::PllPMask(rcc::PllP::Div_4) | rcc::PllSrcMask(rcc::PllSource::Hse));
-    ResetClockCtrlRegs::ConfigReg::set(rcc::APB1PrescalerMask(rcc::APB1Prescaler::Pre_2));
-
-    // Enable PLL and wait until it is stabilised
-    ResetClockCtrlRegs::ClockControlReg::set(rcc::PllOnMask(true));
-    while(!(ResetClockCtrlRegs::ClockControlReg::read(rcc::PllReadyMask())));
-        
-    // Switch to using PLL as system clock and wait until it is stabilised
-    ResetClockCtrlRegs::ConfigReg::set(rcc::SysClkSwitchMask(rcc::SysClkSwitch::Pll));
-    while (!(ResetClockCtrlRegs::ConfigReg::read(rcc::SysClkSwitchStatMask())));
+    // Clock orders voltage scaling, flash wait states, prescalers and PLL for the target frequency
+    Clock::switch_to<SystemClock>();
+
+    // ART accelerator hides most of the wait states
+    Flash::enable_art();
 }
 
+using OnboardLed = gpio::PinSet<gpio::Pins::P5>;
+
 void init_onboard_led()
 {
-    // First enable clock for GPIOA
-    ResetClockCtrlRegs::Ahb1EnableReg::set(rcc::GpioAEnableMask(true));
+    // First enable clock for GPIOA, it stays on while any user holds it
+    ClockGating::acquire<GpioRegs<gpio::Port::A>>();
 
     // Configure mode for PA5 -> onboard LED on NUCLEO-F411RE
-    GpioRegs<gpio::Port::A>::ModeReg::set(gpio::ModeMask<gpio::Pins::P5>(gpio::Mode::Output));
+    OnboardLed::set_mode<gpio::Port::A>(gpio::Mode::Output);
 }
 
 int main()
 {
     system_init();
     init_onboard_led();
+    console_init();
 
-    auto onboard_led_mask = gpio::OutputDataMask<gpio::Pins::P5>();
+    printf("Example started\n");
+    benchmark_boot();
+    benchmark_art();
+    benchmark_irq_entry();
+    benchmark_spi_polled();
+
+    // Round trip through the idle profile, console follows through its clock listener
+    Clock::switch_to<IdleClock>();
+    const uint32_t down_cycles = Clock::last_switch_cycles();
+    Clock::switch_to<SystemClock>();
+    printf("Clock switch: down %lu cycles, up %lu cycles\n", static_cast<unsigned long>(down_cycles),
+           static_cast<unsigned long>(Clock::last_switch_cycles()));
 
     while (true)
     {
         // For precise delay there are better implementation, this is only for example
         for (auto count = 0; count < 9600000; ++count);
         // Turn on led
-        GpioRegs<gpio::Port::A>::OutputDataReg::set(onboard_led_mask);
+        OnboardLed::set<gpio::Port::A>();
         for (auto count = 0; count < 9600000; ++count);
         // Turn off led
-        GpioRegs<gpio::Port::A>::OutputDataReg::clear(onboard_led_mask);
-
+        OnboardLed::reset<gpio::Port::A>();
     }
     return 0;
 }
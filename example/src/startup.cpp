@@ -1,3 +1,5 @@
+#include "core_regs.hpp"
+
 #include <stdint.h>
 #include <cstdio>
 
@@ -7,35 +9,99 @@
 #define STACK_POINTER_INIT_ADDRESS (SRAM_END)
 #define ISR_VECTOR_SIZE_WORDS 102
 
+// Load/run region pairs generated by the linker script, sizes in bytes and multiples of 4
+struct CopyRegion
+{
+  const uint32_t *load;
+  uint32_t *run;
+  uint32_t size;
+};
+
+struct ZeroRegion
+{
+  uint32_t *run;
+  uint32_t size;
+};
+
 extern "C"
 {
-extern uint32_t _etext, _sdata, _edata, _sbss, _ebss, _sidata;
+extern const CopyRegion __copy_table_start__[], __copy_table_end__[];
+extern const ZeroRegion __zero_table_start__[], __zero_table_end__[];
+extern uint32_t __ram_vector_start__[];
+
+// Core cycles from reset to main(), DWT counter is started first thing in reset_handler
+uint32_t boot_cycles;
 }
 int main(void);
 // Init newlib
 extern "C" void __libc_init_array();
-extern "C" void reset_handler(void)
+
+// Loops must not be turned into memcpy/memset calls, the library may not be ready yet
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static inline void copy_words(const uint32_t *src, uint32_t *dst, uint32_t size)
 {
-  // Copy .data from FLASH to SRAM
-  uint32_t data_size = (uint32_t)&_edata - (uint32_t)&_sdata;
-  uint8_t *flash_data = (uint8_t*) &_sidata; // Data load address (in flash)
-  uint8_t *sram_data = (uint8_t*) &_sdata; // Data virtual address (in sram)
-  
-  for (uint32_t i = 0; i < data_size; i++)
+  uint32_t words = size / 4U;
+
+  // Four words per iteration, compiled to LDM/STM pairs
+  for (; words >= 4U; words -= 4U)
   {
-    sram_data[i] = flash_data[i];
+    const uint32_t w0 = src[0], w1 = src[1], w2 = src[2], w3 = src[3];
+    dst[0] = w0;
+    dst[1] = w1;
+    dst[2] = w2;
+    dst[3] = w3;
+    src += 4;
+    dst += 4;
   }
 
-  // Zero-fill .bss section in SRAM
-  uint32_t bss_size = (uint32_t)&_ebss - (uint32_t)&_sbss;
-  uint8_t *bss = (uint8_t*) &_sbss;
+  for (; words != 0U; --words)
+  {
+    *dst++ = *src++;
+  }
+}
+
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static inline void zero_words(uint32_t *dst, uint32_t size)
+{
+  uint32_t words = size / 4U;
 
-  for (uint32_t i = 0; i < bss_size; i++)
+  for (; words >= 4U; words -= 4U)
   {
-    bss[i] = 0;
+    dst[0] = 0U;
+    dst[1] = 0U;
+    dst[2] = 0U;
+    dst[3] = 0U;
+    dst += 4;
+  }
+
+  for (; words != 0U; --words)
+  {
+    *dst++ = 0U;
+  }
+}
+
+extern "C" void reset_handler(void)
+{
+  // Boot time measurement, uses no RAM
+  CycleCounter::enable();
+
+  // Copy .data, .ramfunc and the vector table from FLASH to SRAM
+  for (const CopyRegion *region = __copy_table_start__; region < __copy_table_end__; ++region)
+  {
+    copy_words(region->load, region->run, region->size);
+  }
+
+  // Zero-fill .bss and other zero-initialized regions in SRAM
+  for (const ZeroRegion *region = __zero_table_start__; region < __zero_table_end__; ++region)
+  {
+    zero_words(region->run, region->size);
   }
   
+  // Vector table copy is in SRAM now, no interrupt is enabled yet
+  VectorTable::relocate(__ram_vector_start__);
+
   __libc_init_array();
+  boot_cycles = CycleCounter::now();
   main();
 }
 
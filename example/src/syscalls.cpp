@@ -1,13 +1,65 @@
+#include "console.hpp"
+#include "gpio_regs.hpp"
+#include "rcc_regs.hpp"
+#include "clock.hpp"
+#include "clock_gating.hpp"
+#include "ramfunc.hpp"
+
+#include "stm32f4xx.h"
+
 #include <sys/stat.h>
 #include <sys/times.h>
 
+namespace
+{
+    constexpr usart::BaudRate console_baud = usart::baud<SystemClock::apb1_hz, 115200U>();
+
+    // Output queued before the switch is sent at the old rate, BRR follows the new APB1 clock
+    void console_clock_changed(rcc::ClockEvent event, const rcc::Frequencies& freq)
+    {
+        if (event == rcc::ClockEvent::Before)
+        {
+            Console::flush();
+            return;
+        }
+
+        const usart::BaudRate baud = usart::compute_baud(freq.apb1_hz, 115200U, console_baud.oversampling);
+        UsartRegs<usart::Peripherals::Usart2>::BaudRateReg::write(baud.brr_mask());
+    }
+}
+
+void console_init()
+{
+    using Usart = UsartRegs<usart::Peripherals::Usart2>;
+    constexpr usart::BaudRate baud = console_baud;
+
+    // One store per bus register for all console clocks
+    ClockGating::acquire_all<GpioRegs<gpio::Port::A>, DmaRegs<dma::Peripherals::Dma_1>, Usart>();
+
+    // PA2 -> USART2 TX
+    gpio::PinSet<gpio::Pins::P2>::configure<gpio::Port::A>(gpio::Mode::AltFunc, gpio::OutputType::PushPull, gpio::OutputSpeed::Fast,
+                                                           gpio::PullType::NoPull, gpio::AlternateFunc::AF7);
+
+    Usart::BaudRateReg::write(baud.brr_mask());
+    Usart::ControlReg1::write(baud.oversampling_mask() | usart::TxEnableMask(true) | usart::UsartEnableMask(true));
+
+    NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+
+    Clock::subscribe(console_clock_changed);
+}
+
+// Runs from SRAM, console DMA completion is on the printf path
+HAL_RAMFUNC void dma1_stream6_handler(void)
+{
+    Console::dma_irq_handler();
+}
+
 extern "C" int _write(int file, char *ptr, int len) 
 {
     (void) file;
-    (void) ptr;
-    (void) len;
 
-    return len;
+    // Only copies into the console ring, output that does not fit is dropped and counted
+    return static_cast<int>(Console::write(ptr, static_cast<size_t>(len)));
 }
 
 extern "C" int _fstat(int fd, struct stat *st) 
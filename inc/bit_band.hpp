@@ -0,0 +1,70 @@
+#ifndef _BIT_BAND_HPP_
+#define _BIT_BAND_HPP_
+
+#include <cstdint>
+#include <stdint.h>
+
+/**
+ * @brief Cortex-M4 peripheral bit-band address math, shared by registers and the host simulation.
+ */
+namespace reg
+{
+    /// @brief Start of the peripheral region that is bit-band mapped.
+    inline constexpr uint32_t PERIPH_BASE = 0x40000000UL;
+
+    /// @brief Size of the bit-band mapped peripheral region (1 MB).
+    inline constexpr uint32_t PERIPH_BB_REGION_SIZE = 0x00100000UL;
+
+    /// @brief Start of the peripheral bit-band alias region.
+    inline constexpr uint32_t PERIPH_BB_BASE = 0x42000000UL;
+
+    /**
+     * @brief Checks whether the register address has a bit-band alias.
+     *
+     * @param addr Register address.
+     * @return true if the address is in the bit-band mapped peripheral region.
+     */
+    constexpr bool in_bit_band_region(uint32_t addr)
+    {
+        return (addr >= PERIPH_BASE) && (addr - PERIPH_BASE < PERIPH_BB_REGION_SIZE);
+    }
+
+    /**
+     * @brief Computes bit-band alias address of a register bit.
+     *
+     * Each bit of the region maps to one word of the alias region,
+     * writing 0 or 1 to that word clears or sets only that bit.
+     *
+     * @param addr Register address.
+     * @param bit  Bit position within the register.
+     * @return Alias word address.
+     */
+    constexpr uint32_t bit_band_alias(uint32_t addr, uint32_t bit)
+    {
+        return PERIPH_BB_BASE + (addr - PERIPH_BASE) * 32U + bit * 4U;
+    }
+
+    /// @brief Checks whether the address lies in the peripheral bit-band alias region.
+    constexpr bool is_bit_band_alias(uint32_t alias)
+    {
+        return (alias >= PERIPH_BB_BASE) && (alias - PERIPH_BB_BASE < PERIPH_BB_REGION_SIZE * 32U);
+    }
+
+    /// @brief Register address targeted by the alias word, inverse of `bit_band_alias()`.
+    constexpr uint32_t bit_band_target_addr(uint32_t alias)
+    {
+        return PERIPH_BASE + (((alias - PERIPH_BB_BASE) / 32U) & ~3U);
+    }
+
+    /// @brief Bit position targeted by the alias word, inverse of `bit_band_alias()`.
+    constexpr uint32_t bit_band_target_bit(uint32_t alias)
+    {
+        return ((alias - PERIPH_BB_BASE) % 128U) / 4U;
+    }
+
+    static_assert(bit_band_alias(0x40023800UL, 0) == 0x42470000UL, "RCC_CR HSION alias must match reference manual");
+    static_assert(bit_band_target_addr(bit_band_alias(0x40023870UL, 16)) == 0x40023870UL && bit_band_target_bit(bit_band_alias(0x40023870UL, 16)) == 16,
+                  "Bit-band alias must map back to its register bit");
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef _CLOCK_HPP_
+#define _CLOCK_HPP_
+
+#include "./clock_config.hpp"
+#include "./core_regs.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+namespace rcc
+{
+    /**
+     * @brief Phase of a clock transition reported to listeners.
+     */
+    enum class ClockEvent : uint8_t
+    {
+        Before, ///< Clock is about to change, stop or flush ongoing transfers
+        After   ///< New frequencies are active, recompute baud rates and dividers
+    };
+
+    /// @brief Clock transition listener, frequencies are the old ones with `Before` and the new ones with `After`.
+    using ClockListener = void (*)(ClockEvent event, const Frequencies& freq);
+};
+
+/**
+ * @brief Runtime switching between compile-time clock profiles (dynamic frequency scaling).
+ *
+ * Static class.
+ *
+ * Any `rcc::ClockConfig` is a profile. A transition always passes through HSE, because the PLL
+ * can not be reconfigured while it drives SYSCLK and VOS is only applied while the PLL is off:
+ *  1. flash latency is raised first when the target needs more wait states,
+ *  2. SYSCLK switches to HSE and the target AHB/APB prescalers are applied,
+ *  3. PLL is stopped, VOS and PLL factors are written, PLL is started (PLLRDY, VOSRDY),
+ *  4. SYSCLK switches to the PLL (SWS),
+ *  5. flash latency is lowered last when the target needs less wait states.
+ * Latency therefore never drops below what the running clock requires, in both directions.
+ *
+ * Every flag wait is bounded by `MAX_POLLS` reads, a timeout leaves SYSCLK on HSE with the
+ * target prescalers and returns `StatusCode::Error`, listeners still get `After` with the real
+ * frequencies. HSE has to be running before the first switch (bypass is board specific).
+ * Enable `CycleCounter` to get the transition latency from `last_switch_cycles()`.
+ * Not reentrant, call it from thread context only.
+ */
+class Clock
+{
+    public:
+        /// @brief Registered listeners limit.
+        static constexpr size_t MAX_LISTENERS = 8;
+        /// @brief Upper bound of status reads per flag wait.
+        static constexpr uint32_t MAX_POLLS = 100000;
+
+    private:
+        inline static rcc::ClockListener listeners[MAX_LISTENERS]{};
+        inline static std::atomic<size_t> listener_count{0};
+        inline static rcc::Frequencies current{rcc::RESET_FREQUENCIES};
+        inline static uint32_t switch_cycles = 0;
+
+        template<typename Pred>
+        static bool wait_for(Pred&& ready)
+        {
+            for (uint32_t poll = 0; poll < MAX_POLLS; ++poll)
+            {
+                if (ready())
+                    return true;
+            }
+            return false;
+        }
+
+        static bool switch_source(rcc::SysClkSwitch source)
+        {
+            ResetClockCtrlRegs::ConfigReg::modify_fields(rcc::SysClkSwitchMask(source));
+            return wait_for([source] { return ResetClockCtrlRegs::ConfigReg::read(rcc::SysClkSwitchStatMask()).value == rcc::SysClkSwitchStatMask(source).value; });
+        }
+
+        static bool set_latency(flash::Latency latency)
+        {
+            FlashRegs::AccessControlReg::modify_fields(flash::LatencyMask(latency));
+            // New wait states are in effect once they read back
+            return FlashRegs::AccessControlReg::read(flash::LatencyMask()).value == flash::LatencyMask(latency).value;
+        }
+
+        static void notify(rcc::ClockEvent event)
+        {
+            const size_t count = listener_count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i)
+                listeners[i](event, current);
+        }
+
+    public:
+        Clock() = delete;
+
+        /**
+         * @brief Registers a listener notified before and after every transition.
+         *
+         * @param listener Listener, called from the context of `switch_to()`.
+         * @return `StatusCode::Error` if the registry is full.
+         */
+        static StatusCode subscribe(rcc::ClockListener listener)
+        {
+            const size_t at = listener_count.load(std::memory_order_relaxed);
+            if (listener == nullptr || at == MAX_LISTENERS)
+                return StatusCode::Error;
+
+            listeners[at] = listener;
+            listener_count.store(at + 1, std::memory_order_release);
+            return StatusCode::Ok;
+        }
+
+        /**
+         * @brief Moves the clock tree to the profile.
+         *
+         * @tparam Profile `rcc::ClockConfig` instance.
+         * @return `StatusCode::Error` if HSE is not ready or a flag wait timed out.
+         */
+        template<typename Profile>
+        static StatusCode switch_to()
+        {
+            if (!ResetClockCtrlRegs::ClockControlReg::read(rcc::HseReadyMask()).value)
+                return StatusCode::Error;
+
+            const uint32_t start = CycleCounter::now();
+            notify(rcc::ClockEvent::Before);
+
+            const flash::Latency old_latency = static_cast<flash::Latency>(FlashRegs::AccessControlReg::read(flash::LatencyMask()).value);
+            const bool raise = static_cast<uint8_t>(Profile::latency) > static_cast<uint8_t>(old_latency);
+            bool ok = !raise || set_latency(Profile::latency);
+
+            if (ok && switch_source(rcc::SysClkSwitch::Hse))
+            {
+                ResetClockCtrlRegs::ConfigReg::modify(Profile::bus_prescaler_fields(), Profile::bus_prescalers());
+                const uint32_t hse_hz = Profile::hse_hz;
+                current = {hse_hz, hse_hz, hse_hz / (Profile::sysclk_hz / Profile::apb1_hz), hse_hz / (Profile::sysclk_hz / Profile::apb2_hz)};
+
+                ResetClockCtrlRegs::ClockControlReg::clear(rcc::PllOnMask(true));
+                ok = wait_for([] { return !ResetClockCtrlRegs::ClockControlReg::read(rcc::PllReadyMask()).value; });
+
+                if (ok)
+                {
+                    PowerCtrlRegs::ControlReg::modify_fields(pwr::VoltageScalingOutSelMask(Profile::voltage));
+                    ResetClockCtrlRegs::PllConfigReg::modify(Profile::pll_config_fields(), Profile::pll_config());
+                    ResetClockCtrlRegs::ClockControlReg::set(rcc::PllOnMask(true));
+
+                    ok = wait_for([] { return ResetClockCtrlRegs::ClockControlReg::read(rcc::PllReadyMask()).value; })
+                      && wait_for([] { return PowerCtrlRegs::StatusReg::read(pwr::VoltageScalingReadyMask()).value; })
+                      && switch_source(rcc::SysClkSwitch::Pll);
+                }
+
+                if (ok)
+                {
+                    current = Profile::frequencies();
+                    if (!raise && Profile::latency != old_latency)
+                        ok = set_latency(Profile::latency);
+                }
+            }
+            else
+            {
+                ok = false;
+            }
+
+            notify(rcc::ClockEvent::After);
+            switch_cycles = CycleCounter::now() - start;
+            return ok ? StatusCode::Ok : StatusCode::Error;
+        }
+
+        /// @brief Returns frequencies of the running clock tree as known from the last switch.
+        static rcc::Frequencies frequencies()
+        {
+            return current;
+        }
+
+        /// @brief Returns core cycles spent by the last `switch_to()`, listeners included.
+        static uint32_t last_switch_cycles()
+        {
+            return switch_cycles;
+        }
+};
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef _CLOCKCONFIG_HPP_
+#define _CLOCKCONFIG_HPP_
+
+#include "./rcc_regs.hpp"
+#include "./flash_regs.hpp"
+#include "./pwr_regs.hpp"
+
+#include <stdint.h>
+#include <assert.h>
+#include <type_traits>
+
+namespace rcc
+{
+    /**
+     * @brief Supply voltage range, selects flash wait states (reference manual table 5).
+     */
+    enum class SupplyRange : uint8_t
+    {
+        V1_71_2_1 = 0U, ///< 1.71 V - 2.1 V
+        V2_1_2_4,       ///< 2.1 V - 2.4 V
+        V2_4_2_7,       ///< 2.4 V - 2.7 V
+        V2_7_3_6        ///< 2.7 V - 3.6 V
+    };
+
+    /// @brief STM32F411 clock tree limits.
+    inline constexpr uint32_t SYSCLK_MAX_HZ   = 100000000UL;
+    inline constexpr uint32_t APB1_MAX_HZ     = 50000000UL;
+    inline constexpr uint32_t APB2_MAX_HZ     = 100000000UL;
+    inline constexpr uint32_t VCO_IN_MIN_HZ   = 1000000UL;
+    inline constexpr uint32_t VCO_IN_MAX_HZ   = 2000000UL;
+    inline constexpr uint32_t VCO_OUT_MIN_HZ  = 100000000UL;
+    inline constexpr uint32_t VCO_OUT_MAX_HZ  = 432000000UL;
+    inline constexpr uint32_t PLL48_MAX_HZ    = 48000000UL;
+
+    /**
+     * @brief Bus frequencies of a running clock tree.
+     */
+    struct Frequencies
+    {
+        uint32_t sysclk_hz;
+        uint32_t hclk_hz;
+        uint32_t apb1_hz;
+        uint32_t apb2_hz;
+    };
+
+    /// @brief Clock tree after reset: SYSCLK from the 16 MHz HSI, no prescalers.
+    inline constexpr Frequencies RESET_FREQUENCIES = {16000000UL, 16000000UL, 16000000UL, 16000000UL};
+
+    /**
+     * @brief PLL factors found by `solve_pll()`.
+     */
+    struct PllFactors
+    {
+        uint32_t m;
+        uint32_t n;
+        uint32_t p;
+        uint32_t q;
+        bool found;
+    };
+
+    /**
+     * @brief Searches PLL factors giving exactly `sysclk_hz` from `source_hz`.
+     *
+     * VCO input is kept within 1-2 MHz and VCO output within 100-432 MHz, the highest VCO input
+     * (lowest jitter) is preferred. Q is the smallest divider keeping the 48 MHz domain at or below
+     * 48 MHz, or with `usb48` the one giving exactly 48 MHz.
+     */
+    constexpr PllFactors solve_pll(uint32_t source_hz, uint32_t sysclk_hz, bool usb48)
+    {
+        for (uint32_t m = 2; m <= 63; ++m)
+        {
+            if (source_hz < m * VCO_IN_MIN_HZ || source_hz > m * VCO_IN_MAX_HZ)
+                continue;
+
+            for (uint32_t p = 2; p <= 8; p += 2)
+            {
+                const uint64_t n_scaled = static_cast<uint64_t>(sysclk_hz) * p * m;
+                if (n_scaled % source_hz != 0)
+                    continue;
+
+                const uint64_t n = n_scaled / source_hz;
+                const uint64_t vco = static_cast<uint64_t>(sysclk_hz) * p;
+                if (n < 50 || n > 432 || vco < VCO_OUT_MIN_HZ || vco > VCO_OUT_MAX_HZ)
+                    continue;
+
+                for (uint32_t q = 2; q <= 15; ++q)
+                {
+                    const bool fits = usb48 ? (vco == static_cast<uint64_t>(PLL48_MAX_HZ) * q) : (vco <= static_cast<uint64_t>(PLL48_MAX_HZ) * q);
+                    if (fits)
+                        return {m, static_cast<uint32_t>(n), p, q, true};
+                }
+            }
+        }
+
+        return {0, 0, 0, 0, false};
+    }
+
+    /// @brief Smallest APB divider (power of two up to 16) keeping the bus at or below `max_hz`.
+    constexpr uint32_t apb_divider(uint32_t hclk_hz, uint32_t max_hz)
+    {
+        uint32_t div = 1;
+        while (div < 16 && hclk_hz / div > max_hz)
+            div *= 2;
+        return div;
+    }
+
+    /// @brief Minimal flash wait states for HCLK and supply range (reference manual table 5).
+    constexpr flash::Latency flash_latency(uint32_t hclk_hz, SupplyRange supply)
+    {
+        constexpr uint32_t step_mhz[] = {16, 18, 24, 30};
+        const uint32_t step = step_mhz[static_cast<uint8_t>(supply)] * 1000000UL;
+        // Highest supply range allows 64 MHz at 1 WS and 90 MHz at 2 WS, others follow linear steps
+        if (supply == SupplyRange::V2_7_3_6)
+            return (hclk_hz <= 30000000UL) ? flash::Latency::WaitState_0
+                 : (hclk_hz <= 64000000UL) ? flash::Latency::WaitState_1
+                 : (hclk_hz <= 90000000UL) ? flash::Latency::WaitState_2
+                 : flash::Latency::WaitState_3;
+
+        const uint32_t ws = (hclk_hz - 1) / step;
+        return static_cast<flash::Latency>(ws);
+    }
+
+    /// @brief Lowest regulator scale supporting HCLK (scale 3 up to 64 MHz, scale 2 up to 84 MHz).
+    constexpr pwr::VoltageScalingOutSel voltage_scale(uint32_t hclk_hz)
+    {
+        if (hclk_hz <= 64000000UL)
+            return pwr::VoltageScalingOutSel::Scale_3;
+        if (hclk_hz <= 84000000UL)
+            return pwr::VoltageScalingOutSel::Scale_2;
+        return pwr::VoltageScalingOutSel::Scale_1;
+    }
+
+    constexpr APB1Prescaler apb1_prescaler(uint32_t div)
+    {
+        return (div == 1) ? APB1Prescaler::Pre_0 : (div == 2) ? APB1Prescaler::Pre_2 : (div == 4) ? APB1Prescaler::Pre_4
+             : (div == 8) ? APB1Prescaler::Pre_8 : APB1Prescaler::Pre_16;
+    }
+
+    constexpr APB2Prescaler apb2_prescaler(uint32_t div)
+    {
+        return (div == 1) ? APB2Prescaler::Pre_0 : (div == 2) ? APB2Prescaler::Pre_2 : (div == 4) ? APB2Prescaler::Pre_4
+             : (div == 8) ? APB2Prescaler::Pre_8 : APB2Prescaler::Pre_16;
+    }
+
+    /**
+     * @brief Compile-time clock tree for SYSCLK from HSE through the main PLL.
+     *
+     * Every value is computed at compile time, an unreachable or illegal configuration is a compile error.
+     * AHB runs undivided, APB1 and APB2 use the smallest dividers within their limits.
+     *
+     * @tparam HseHz          HSE frequency.
+     * @tparam TargetSysclkHz Requested SYSCLK, reached exactly.
+     * @tparam Usb48          Require exactly 48 MHz on the PLL48CK output (USB OTG FS, SDIO).
+     * @tparam Supply         Supply voltage range, selects flash wait states.
+     */
+    template<uint32_t HseHz, uint32_t TargetSysclkHz, bool Usb48 = false, SupplyRange Supply = SupplyRange::V2_7_3_6>
+    struct ClockConfig
+    {
+        static_assert(HseHz >= 4000000UL && HseHz <= 26000000UL, "HSE must be within 4-26 MHz");
+        static_assert(TargetSysclkHz <= SYSCLK_MAX_HZ, "SYSCLK above 100 MHz");
+
+        private:
+            static constexpr PllFactors pll = solve_pll(HseHz, TargetSysclkHz, Usb48);
+            static_assert(pll.found, "No PLL factors reach the target SYSCLK exactly within VCO limits");
+
+            static constexpr uint32_t apb1_div = apb_divider(TargetSysclkHz, APB1_MAX_HZ);
+            static constexpr uint32_t apb2_div = apb_divider(TargetSysclkHz, APB2_MAX_HZ);
+
+        public:
+            static constexpr uint32_t hse_hz    = HseHz;
+            static constexpr uint32_t sysclk_hz = TargetSysclkHz;
+            static constexpr uint32_t hclk_hz   = TargetSysclkHz;
+            static constexpr uint32_t apb1_hz   = TargetSysclkHz / apb1_div;
+            static constexpr uint32_t apb2_hz   = TargetSysclkHz / apb2_div;
+            /// @brief Timer kernel clocks, doubled when the APB divider is not 1.
+            static constexpr uint32_t apb1_timer_hz = (apb1_div == 1) ? apb1_hz : apb1_hz * 2;
+            static constexpr uint32_t apb2_timer_hz = (apb2_div == 1) ? apb2_hz : apb2_hz * 2;
+            static constexpr uint32_t pll48_hz  = static_cast<uint32_t>(static_cast<uint64_t>(TargetSysclkHz) * pll.p / pll.q);
+
+            static constexpr uint32_t pll_m = pll.m;
+            static constexpr uint32_t pll_n = pll.n;
+            static constexpr PllP pll_p     = static_cast<PllP>(pll.p / 2 - 1);
+            static constexpr uint32_t pll_q = pll.q;
+
+            static constexpr AHBPrescaler ahb_prescaler   = AHBPrescaler::Pre_0;
+            static constexpr APB1Prescaler apb1_prescaler = rcc::apb1_prescaler(apb1_div);
+            static constexpr APB2Prescaler apb2_prescaler = rcc::apb2_prescaler(apb2_div);
+
+            static constexpr flash::Latency latency             = flash_latency(hclk_hz, Supply);
+            static constexpr pwr::VoltageScalingOutSel voltage  = voltage_scale(hclk_hz);
+
+            /// @brief Bus frequencies of this configuration.
+            static constexpr Frequencies frequencies()
+            {
+                return {sysclk_hz, hclk_hz, apb1_hz, apb2_hz};
+            }
+
+            /// @brief PLLCFGR fields to clear before writing `pll_config()`.
+            static constexpr auto pll_config_fields()
+            {
+                return PllMMask() | PllNMask() | PllPMask() | PllQMask() | PllSrcMask();
+            }
+
+            /// @brief PLLCFGR value with HSE as PLL source.
+            static constexpr auto pll_config()
+            {
+                return PllMMask(pll_m) | PllNMask(pll_n) | PllPMask(pll_p) | PllQMask(pll_q) | PllSrcMask(PllSource::Hse);
+            }
+
+            /// @brief CFGR prescaler fields to clear before writing `bus_prescalers()`.
+            static constexpr auto bus_prescaler_fields()
+            {
+                return AHBPrescalerMask() | APB1PrescalerMask() | APB2PrescalerMask();
+            }
+
+            /// @brief CFGR prescaler values.
+            static constexpr auto bus_prescalers()
+            {
+                return AHBPrescalerMask(ahb_prescaler) | APB1PrescalerMask(apb1_prescaler) | APB2PrescalerMask(apb2_prescaler);
+            }
+    };
+};
+
+// Reference configurations, values as listed in the reference manual clock tree
+static_assert(rcc::ClockConfig<8000000UL, 100000000UL>::pll_m == 4 && rcc::ClockConfig<8000000UL, 100000000UL>::pll_n == 100, "PLL solver mismatch");
+static_assert(rcc::ClockConfig<8000000UL, 100000000UL>::apb1_hz == 50000000UL, "APB1 prescaler mismatch");
+static_assert(rcc::ClockConfig<8000000UL, 100000000UL>::latency == flash::Latency::WaitState_3, "Flash latency mismatch");
+static_assert(rcc::ClockConfig<8000000UL, 96000000UL, true>::pll48_hz == 48000000UL, "PLL48 solver mismatch");
+static_assert(rcc::ClockConfig<25000000UL, 84000000UL>::voltage == pwr::VoltageScalingOutSel::Scale_2, "Voltage scale mismatch");
+
+#endif
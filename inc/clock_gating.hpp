@@ -0,0 +1,190 @@
+#ifndef _CLOCKGATING_HPP_
+#define _CLOCKGATING_HPP_
+
+#include "./rcc_regs.hpp"
+#include "./gpio_regs.hpp"
+#include "./spi_regs.hpp"
+#include "./usart_regs.hpp"
+#include "./dma_regs.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdint.h>
+#include <type_traits>
+
+namespace rcc
+{
+    /**
+     * @brief Bus register pair (enable and reset) a peripheral clock hangs on.
+     */
+    struct Ahb1Bus
+    {
+        using EnableReg = ResetClockCtrlRegs::Ahb1EnableReg;
+        using ResetReg  = ResetClockCtrlRegs::Ahb1ResetReg;
+    };
+
+    struct Apb1Bus
+    {
+        using EnableReg = ResetClockCtrlRegs::Apb1EnableReg;
+        using ResetReg  = ResetClockCtrlRegs::Apb1ResetReg;
+    };
+
+    struct Apb2Bus
+    {
+        using EnableReg = ResetClockCtrlRegs::Apb2EnableReg;
+        using ResetReg  = ResetClockCtrlRegs::Apb2ResetReg;
+    };
+
+    /**
+     * @brief Compile-time mapping of a peripheral register class to its RCC enable and reset bits.
+     *
+     * Each specialization provides `Bus` (`Ahb1Bus`, `Apb1Bus`, `Apb2Bus`), `EnableMask` and `ResetMask`.
+     *
+     * @tparam Periph Peripheral register class, e.g. `GpioRegs<gpio::Port::A>`.
+     */
+    template<typename Periph>
+    struct ClockGate;
+
+    template<> struct ClockGate<GpioRegs<gpio::Port::A>> { using Bus = Ahb1Bus; using EnableMask = GpioAEnableMask; using ResetMask = GpioAResetMask; };
+    template<> struct ClockGate<GpioRegs<gpio::Port::B>> { using Bus = Ahb1Bus; using EnableMask = GpioBEnableMask; using ResetMask = GpioBResetMask; };
+    template<> struct ClockGate<GpioRegs<gpio::Port::C>> { using Bus = Ahb1Bus; using EnableMask = GpioCEnableMask; using ResetMask = GpioCResetMask; };
+    template<> struct ClockGate<GpioRegs<gpio::Port::D>> { using Bus = Ahb1Bus; using EnableMask = GpioDEnableMask; using ResetMask = GpioDResetMask; };
+    template<> struct ClockGate<GpioRegs<gpio::Port::E>> { using Bus = Ahb1Bus; using EnableMask = GpioEEnableMask; using ResetMask = GpioEResetMask; };
+    template<> struct ClockGate<GpioRegs<gpio::Port::H>> { using Bus = Ahb1Bus; using EnableMask = GpioHEnableMask; using ResetMask = GpioHResetMask; };
+
+    template<> struct ClockGate<DmaRegs<dma::Peripherals::Dma_1>> { using Bus = Ahb1Bus; using EnableMask = DMA1EnableMask; using ResetMask = DMA1ResetMask; };
+    template<> struct ClockGate<DmaRegs<dma::Peripherals::Dma_2>> { using Bus = Ahb1Bus; using EnableMask = DMA2EnableMask; using ResetMask = DMA2ResetMask; };
+
+    template<> struct ClockGate<SpiRegs<spi::Peripherals::Spi_1>> { using Bus = Apb2Bus; using EnableMask = Spi1EnableMask; using ResetMask = Spi1ResetMask; };
+    template<> struct ClockGate<SpiRegs<spi::Peripherals::Spi_2>> { using Bus = Apb1Bus; using EnableMask = Spi2EnableMask; using ResetMask = Spi2ResetMask; };
+    template<> struct ClockGate<SpiRegs<spi::Peripherals::Spi_3>> { using Bus = Apb1Bus; using EnableMask = Spi3EnableMask; using ResetMask = Spi3ResetMask; };
+    template<> struct ClockGate<SpiRegs<spi::Peripherals::Spi_4>> { using Bus = Apb2Bus; using EnableMask = Spi4EnableMask; using ResetMask = Spi4ResetMask; };
+    template<> struct ClockGate<SpiRegs<spi::Peripherals::Spi_5>> { using Bus = Apb2Bus; using EnableMask = Spi5EnableMask; using ResetMask = Spi5ResetMask; };
+
+    template<> struct ClockGate<UsartRegs<usart::Peripherals::Usart1>> { using Bus = Apb2Bus; using EnableMask = Usart1EnableMask; using ResetMask = Usart1ResetMask; };
+    template<> struct ClockGate<UsartRegs<usart::Peripherals::Usart2>> { using Bus = Apb1Bus; using EnableMask = Usart2EnableMask; using ResetMask = Usart2ResetMask; };
+    template<> struct ClockGate<UsartRegs<usart::Peripherals::Usart6>> { using Bus = Apb2Bus; using EnableMask = Usart6EnableMask; using ResetMask = Usart6ResetMask; };
+};
+
+/**
+ * @brief Reference counted peripheral clock gating.
+ *
+ * Static class.
+ *
+ * A clock runs while at least one reference is held and is disabled by the last `release()`,
+ * so every driver can hold the clocks it needs and nothing stays running when no one does.
+ * Enable and disable are single bit-band stores, safe against other peripherals on the same bus
+ * register. Every `acquire()` does the enable store, which is idempotent: a context that preempts
+ * the first `acquire()` between the count update and the enable still returns with the clock
+ * running. A context that preempts the last `release()` of a peripheral and acquires it again
+ * gets its clock back before `release()` returns.
+ *
+ * `acquire_all()` is the startup mode: clocks of the listed peripherals are enabled with one store
+ * per bus register and each of them is acquired once.
+ */
+class ClockGating
+{
+    private:
+        template<typename Periph>
+        inline static std::atomic<uint32_t> refs{0};
+
+        template<typename Periph>
+        static void enable()
+        {
+            using Gate = rcc::ClockGate<Periph>;
+            Gate::Bus::EnableReg::set(typename Gate::EnableMask(true));
+            // Read back delays the first peripheral access until the clock runs (RCC errata)
+            (void) Gate::Bus::EnableReg::read(typename Gate::EnableMask());
+        }
+
+        template<typename Bus, typename... Periphs>
+        static constexpr uint32_t bus_bits()
+        {
+            return ((std::is_same_v<typename rcc::ClockGate<Periphs>::Bus, Bus> ? typename rcc::ClockGate<Periphs>::EnableMask(true).value : 0U) | ... | 0U);
+        }
+
+        template<typename Bus, typename... Periphs>
+        static void enable_bus()
+        {
+            constexpr uint32_t bits = bus_bits<Bus, Periphs...>();
+            if constexpr (bits != 0)
+            {
+                using Tag = typename Bus::EnableReg::tag_type;
+                Bus::EnableReg::set(RegisterMask<Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{bits});
+                (void) Bus::EnableReg::read(RegisterMask<Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{bits});
+            }
+        }
+
+    public:
+        ClockGating() = delete;
+
+        /// @brief Takes a reference on the peripheral clock, the clock runs when it returns.
+        template<typename Periph>
+        static StatusCode acquire()
+        {
+            refs<Periph>.fetch_add(1, std::memory_order_acq_rel);
+            // Not only on the first reference, the first acquirer may not have enabled it yet
+            enable<Periph>();
+            return StatusCode::Ok;
+        }
+
+        /**
+         * @brief Drops a reference on the peripheral clock, disables it with the last one.
+         *
+         * @return `StatusCode::Error` if the peripheral was not acquired.
+         */
+        template<typename Periph>
+        static StatusCode release()
+        {
+            using Gate = rcc::ClockGate<Periph>;
+            uint32_t count = refs<Periph>.load(std::memory_order_relaxed);
+            do
+            {
+                if (count == 0)
+                    return StatusCode::Error;
+            } while (!refs<Periph>.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel));
+
+            if (count == 1)
+            {
+                Gate::Bus::EnableReg::clear(typename Gate::EnableMask(true));
+                // Acquired again while the clock was being stopped
+                if (refs<Periph>.load(std::memory_order_acquire) != 0)
+                    enable<Periph>();
+            }
+            return StatusCode::Ok;
+        }
+
+        /// @brief Returns number of references held on the peripheral clock.
+        template<typename Periph>
+        static uint32_t users()
+        {
+            return refs<Periph>.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Pulses the peripheral reset, all its registers return to reset values.
+        template<typename Periph>
+        static StatusCode reset()
+        {
+            using Gate = rcc::ClockGate<Periph>;
+            Gate::Bus::ResetReg::set(typename Gate::ResetMask(true));
+            return Gate::Bus::ResetReg::clear(typename Gate::ResetMask(true));
+        }
+
+        /**
+         * @brief Acquires all listed peripherals, clocks are enabled with one store per bus register.
+         *
+         * @tparam Periphs Peripheral register classes used by the program.
+         */
+        template<typename... Periphs>
+        static StatusCode acquire_all()
+        {
+            (refs<Periphs>.fetch_add(1, std::memory_order_acq_rel), ...);
+
+            enable_bus<rcc::Ahb1Bus, Periphs...>();
+            enable_bus<rcc::Apb1Bus, Periphs...>();
+            enable_bus<rcc::Apb2Bus, Periphs...>();
+            return StatusCode::Ok;
+        }
+};
+
+#endif
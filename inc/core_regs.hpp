@@ -0,0 +1,137 @@
+#ifndef _COREREGS_HPP_
+#define _COREREGS_HPP_
+
+#include "./register_base.hpp"
+
+#include <stdint.h>
+#include <assert.h>
+#include <type_traits>
+
+namespace core
+{
+    struct DEMCR_Tag {};
+    struct DWT_CTRL_Tag {};
+    struct DWT_CYCCNT_Tag {};
+    struct VTOR_Tag {};
+
+    using TraceEnableMask    = RegisterMask<DEMCR_Tag,      reg::BitFieldAccessFlag::RW, 1,  24, bool>;
+    using CycleCountEnMask   = RegisterMask<DWT_CTRL_Tag,   reg::BitFieldAccessFlag::RW, 1,  0,  bool>;
+    using CycleCountMask     = RegisterMask<DWT_CYCCNT_Tag, reg::BitFieldAccessFlag::RW, 32, 0,  uint32_t>;
+    using VectorTableOffMask = RegisterMask<VTOR_Tag,       reg::BitFieldAccessFlag::RW, 23, 7,  uint32_t>;
+};
+
+/**
+ * @brief Cortex-M4 debug and trace registers abstraction.
+ *
+ * Static class.
+ */
+class CoreDebugRegs
+{
+    private:
+        inline static constexpr uint32_t DWT_BASE_ADDR = 0xE0001000UL;
+        inline static constexpr uint32_t DCB_BASE_ADDR = 0xE000EDF0UL;
+    public:
+        CoreDebugRegs() = delete;
+
+        using DebugExcMonCtrlReg = Register<core::DEMCR_Tag,      DCB_BASE_ADDR + 0x0C>;
+        using DwtControlReg      = Register<core::DWT_CTRL_Tag,   DWT_BASE_ADDR + 0x00>;
+        using DwtCycleCountReg   = Register<core::DWT_CYCCNT_Tag, DWT_BASE_ADDR + 0x04>;
+};
+
+/**
+ * @brief Cortex-M4 system control block registers abstraction.
+ *
+ * Static class.
+ */
+class SystemCtrlBlockRegs
+{
+    private:
+        inline static constexpr uint32_t BASE_ADDR = 0xE000ED00UL;
+    public:
+        SystemCtrlBlockRegs() = delete;
+
+        using VectorTableOffsetReg = Register<core::VTOR_Tag, BASE_ADDR + 0x08>;
+};
+
+/**
+ * @brief Vector table relocation through VTOR.
+ *
+ * Static class.
+ */
+class VectorTable
+{
+    public:
+        /// @brief Table alignment, 102 STM32F411 entries rounded up to a power of two.
+        static constexpr uint32_t ALIGNMENT = 512;
+
+        VectorTable() = delete;
+
+        /**
+         * @brief Points the core to the vector table, e.g. a copy in SRAM.
+         *
+         * Interrupts taken after the write use the new table, add a DSB if one may be pending.
+         *
+         * @param table Vector table, aligned to `ALIGNMENT`.
+         * @return `StatusCode::Error` if the table is misaligned.
+         */
+        static StatusCode relocate(const uint32_t* table)
+        {
+            const uint32_t addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(table));
+            if (addr % ALIGNMENT != 0)
+                return StatusCode::Error;
+
+            return SystemCtrlBlockRegs::VectorTableOffsetReg::write(core::VectorTableOffMask(addr >> 7));
+        }
+
+        /// @brief Returns address of the active vector table.
+        static uint32_t address()
+        {
+            // TBLOFF (bits 29:7) read as raw bits is the table address itself
+            return SystemCtrlBlockRegs::VectorTableOffsetReg::read(
+                RegisterMask<core::VTOR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{core::VectorTableOffMask().value}).value;
+        }
+};
+
+/**
+ * @brief Core clock cycle counter (DWT CYCCNT), used for on-target benchmarks.
+ *
+ * Static class.
+ *
+ * Counter wraps around after 2^32 cycles, differences of two `now()` values stay valid
+ * across a single wrap.
+ */
+class CycleCounter
+{
+    public:
+        CycleCounter() = delete;
+
+        /// @brief Enables trace block and starts the counter from zero.
+        static StatusCode enable()
+        {
+            CoreDebugRegs::DebugExcMonCtrlReg::set(core::TraceEnableMask(true));
+            CoreDebugRegs::DwtCycleCountReg::write(core::CycleCountMask(0));
+            return CoreDebugRegs::DwtControlReg::set(core::CycleCountEnMask(true));
+        }
+
+        /// @brief Returns current cycle count.
+        static uint32_t now()
+        {
+            return CoreDebugRegs::DwtCycleCountReg::read(core::CycleCountMask()).value;
+        }
+
+        /**
+         * @brief Measures cycles spent in the callable.
+         *
+         * @param fn Callable to measure.
+         * @return Elapsed core cycles, including the counter read overhead.
+         */
+        template<typename Fn>
+        static uint32_t measure(Fn&& fn)
+        {
+            const uint32_t start = now();
+            fn();
+            return now() - start;
+        }
+};
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef _DMAMEMCPY_HPP_
+#define _DMAMEMCPY_HPP_
+
+#include "dma_stream.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+
+/**
+ * @brief Asynchronous memcpy/memset on a DMA2 memory-to-memory stream.
+ *
+ * Static class.
+ *
+ * Data size is the widest one allowed by alignment of both addresses and the length,
+ * FIFO is enabled with full threshold. Each chunk uses 4-beat bursts when its addresses are
+ * aligned to the burst and its item count is a multiple of it, a remainder of less than
+ * 4 items goes out as a last chunk of single transfers.
+ * Transfers above the 65535 item limit of SxNDTR are split into chunks of a whole number of bursts.
+ * The next chunk is started from `irq_handler()`, which has to be called from the stream
+ * interrupt handler, or in polled mode from `poll()`, which completion checks call themselves.
+ *
+ * Only one transfer runs at a time, starting a new one waits for the previous one.
+ * Results of the last 32 transfers are kept for their handles.
+ *
+ * @tparam Stream DMA2 stream dedicated to memory transfers.
+ * @tparam Polled Progress transfers by polling instead of the stream interrupt.
+ */
+template<dma::Streams Stream = dma::Streams::Stream_0, bool Polled = false>
+class DmaMemcpy
+{
+    private:
+        using Engine = DmaMemStream<Stream>;
+
+        static constexpr uint32_t BURST_BEATS = 4U;
+        static constexpr uint32_t MAX_ITEMS = 0xFFFFU & ~(BURST_BEATS - 1);
+
+        inline static volatile uint32_t src_addr{};
+        inline static volatile uint32_t dst_addr{};
+        inline static volatile uint32_t remaining_bytes{};
+        inline static volatile uint32_t started{};
+        inline static volatile uint32_t finished{};
+        inline static volatile uint32_t failed_mask{};
+        inline static dma::StreamConfig config{};
+        inline static uint32_t fill_pattern{};
+
+        static constexpr dma::DataSize widest_size(uint32_t dst, uint32_t src, uint32_t len)
+        {
+            const uint32_t alignment = dst | src | len;
+            if ((alignment & 3U) == 0)
+                return dma::DataSize::Word;
+            if ((alignment & 1U) == 0)
+                return dma::DataSize::HalfWord;
+            return dma::DataSize::Byte;
+        }
+
+        static constexpr uint32_t sequence_bit(uint32_t sequence)
+        {
+            return 1U << (sequence & 31U);
+        }
+
+        static void finish(bool error)
+        {
+            if (error)
+                failed_mask = failed_mask | sequence_bit(started);
+            finished = started;
+        }
+
+        static StatusCode start_chunk()
+        {
+            const uint32_t size_shift = static_cast<uint32_t>(config.periph_size);
+            const bool src_incr = (config.periph_incr == dma::AddrIncrementMode::AddrPtrIncr);
+            const uint32_t src = src_addr;
+            const uint32_t dst = dst_addr;
+            uint32_t items = remaining_bytes >> size_shift;
+            if (items > MAX_ITEMS)
+                items = MAX_ITEMS;
+
+            // Burst aligned addresses never cross a 1 KB boundary within a burst
+            const uint32_t burst_bytes = BURST_BEATS << size_shift;
+            const bool burst = (items >= BURST_BEATS) && (((dst | (src_incr ? src : 0U)) & (burst_bytes - 1)) == 0);
+            if (burst)
+                items &= ~(BURST_BEATS - 1);
+            config.periph_burst = (burst && src_incr) ? dma::BurstSize::Incr_4 : dma::BurstSize::Single;
+            config.mem_burst = burst ? dma::BurstSize::Incr_4 : dma::BurstSize::Single;
+
+            const uint32_t bytes = items << size_shift;
+            if (src_incr)
+                src_addr = src + bytes;
+            dst_addr = dst + bytes;
+            remaining_bytes = remaining_bytes - bytes;
+
+            const StatusCode status = Engine::start(config, src, dst, static_cast<uint16_t>(items));
+            if (status != StatusCode::Ok)
+                finish(true);
+            return status;
+        }
+
+        static StatusCode begin(uint32_t dst, uint32_t src, uint32_t len, dma::AddrIncrementMode src_incr)
+        {
+            wait_idle();
+
+            const dma::DataSize size = widest_size(dst, (src_incr == dma::AddrIncrementMode::AddrPtrIncr) ? src : 0U, len);
+
+            config = dma::StreamConfig{
+                .direction = dma::TransferDirection::MemToMem,
+                .periph_size = size,
+                .mem_size = size,
+                .periph_incr = src_incr,
+                .mem_incr = dma::AddrIncrementMode::AddrPtrIncr,
+                .tx_complete_irq = !Polled,
+                .tx_error_irq = !Polled,
+                .fifo = true,
+                .fifo_threshold = dma::FifoThreshold::Full_100
+            };
+
+            src_addr = src;
+            dst_addr = dst;
+            remaining_bytes = len;
+            started = started + 1;
+            failed_mask = failed_mask & ~sequence_bit(started);
+
+            if (len == 0)
+            {
+                finish(false);
+                return StatusCode::Ok;
+            }
+
+            return start_chunk();
+        }
+
+    public:
+        DmaMemcpy() = delete;
+
+        /**
+         * @brief Completion handle of a started transfer.
+         */
+        class Handle
+        {
+            private:
+                uint32_t sequence;
+
+            public:
+                constexpr explicit Handle(uint32_t seq) : sequence{seq} {}
+
+                /// @brief Returns true once the transfer finished.
+                bool is_done() const
+                {
+                    if constexpr (Polled)
+                        DmaMemcpy::poll();
+                    return static_cast<int32_t>(DmaMemcpy::finished - sequence) >= 0;
+                }
+
+                /// @brief Blocks until the transfer finished.
+                StatusCode wait() const
+                {
+                    while (!is_done());
+                    return status();
+                }
+
+                /// @brief Returns `StatusCode::Error` if this transfer hit a DMA error, valid once it is done.
+                StatusCode status() const
+                {
+                    return (DmaMemcpy::failed_mask & sequence_bit(sequence)) ? StatusCode::Error : StatusCode::Ok;
+                }
+        };
+
+        /**
+         * @brief Starts copying `len` bytes from `src` to `dst`.
+         *
+         * Both buffers must stay valid until the handle reports completion.
+         *
+         * @param dst Destination buffer.
+         * @param src Source buffer.
+         * @param len Number of bytes.
+         * @return Completion handle.
+         */
+        static Handle copy(void* dst, const void* src, size_t len)
+        {
+            begin(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(dst)), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(src)),
+                  static_cast<uint32_t>(len), dma::AddrIncrementMode::AddrPtrIncr);
+            return Handle{started};
+        }
+
+        /**
+         * @brief Starts filling `len` bytes of `dst` with `value`.
+         *
+         * Source is a replicated pattern word read with fixed address.
+         *
+         * @param dst   Destination buffer.
+         * @param value Byte value.
+         * @param len   Number of bytes.
+         * @return Completion handle.
+         */
+        static Handle fill(void* dst, uint8_t value, size_t len)
+        {
+            wait_idle();
+            fill_pattern = value * 0x01010101U;
+            begin(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(dst)), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&fill_pattern)),
+                  static_cast<uint32_t>(len), dma::AddrIncrementMode::AddrPtrFixed);
+            return Handle{started};
+        }
+
+        /// @brief Returns true while a transfer is running.
+        static bool is_busy()
+        {
+            if constexpr (Polled)
+                poll();
+            return finished != started;
+        }
+
+        /// @brief Blocks until the running transfer finished.
+        static void wait_idle()
+        {
+            while (is_busy());
+        }
+
+        /**
+         * @brief Handles end of chunk, call it from the stream interrupt handler.
+         *
+         * Starts the next chunk or marks the transfer finished.
+         */
+        static void irq_handler()
+        {
+            if (finished == started)
+                return;
+
+            if (Engine::has_error())
+            {
+                Engine::clear_flags();
+                finish(true);
+                return;
+            }
+
+            if (!Engine::is_complete())
+                return;
+
+            Engine::clear_flags();
+            if (remaining_bytes != 0)
+                start_chunk();
+            else
+                finish(false);
+        }
+
+        /// @brief Progresses the transfer in polled mode, same as `irq_handler()`.
+        static void poll()
+        {
+            static_assert(Polled, "Interrupt driven instance is progressed by irq_handler()");
+            irq_handler();
+        }
+};
+
+#endif
@@ -74,6 +74,20 @@ namespace dma
         Full_100
     };
 
+    enum class BurstSize : uint8_t
+    {
+        Single = 0U,
+        Incr_4,
+        Incr_8,
+        Incr_16
+    };
+
+    enum class CurrentTarget : uint8_t
+    {
+        Memory_0 = 0U,
+        Memory_1
+    };
+
     enum class FifoStatus : uint8_t
     {
         Less_25 = 0U,
@@ -84,6 +98,24 @@ namespace dma
         Full
     };
 
+    /// @brief Position of the flag group of each stream in LISR/HISR and LIFCR/HIFCR.
+    constexpr uint32_t StatusGroupPos[] =
+    {
+        0, 6, 16, 22,
+        0, 6, 16, 22
+    };
+
+    /// @brief Flag offsets within the stream flag group.
+    enum class StatusFlag : uint8_t
+    {
+        FifoError       = 0U,
+        DirectModeError = 2U,
+        TxError         = 3U,
+        HalfTx          = 4U,
+        TxComplete      = 5U
+    };
+
+    /// @brief Position of transfer complete flag of each stream.
     constexpr uint32_t StatusFieldsPos[] = 
     {
         5, 11, 21, 27,
@@ -110,11 +142,11 @@ namespace dma
 
     struct SxFCR_Tag {};
 
-    template<typename Tag, reg::BitFieldAccessFlag AccessFlag, Streams Stream>
-    struct StatusMask : RegisterMask<Tag, AccessFlag, 1, StatusFieldsPos[static_cast<uint8_t>(Stream)]> 
+    template<typename Tag, reg::BitFieldAccessFlag AccessFlag, Streams Stream, StatusFlag Flag = StatusFlag::TxComplete>
+    struct StatusMask : RegisterMask<Tag, AccessFlag, 1, StatusGroupPos[static_cast<uint8_t>(Stream)] + static_cast<uint32_t>(Flag)> 
     {
         constexpr StatusMask()
-            : RegisterMask<Tag, AccessFlag, 1, StatusFieldsPos[static_cast<uint8_t>(Stream)]>() 
+            : RegisterMask<Tag, AccessFlag, 1, StatusGroupPos[static_cast<uint8_t>(Stream)] + static_cast<uint32_t>(Flag)>() 
         {
             if constexpr (std::is_same_v<Tag, LISR_Tag> || std::is_same_v<Tag, LIFCR_Tag>)
                 static_assert(static_cast<uint8_t>(Stream) < 4, "I don't belong here, I belong in HIGH register ;) !");
@@ -123,11 +155,65 @@ namespace dma
         }
     };
 
+    /// @brief Interrupt status register tag (LISR/HISR) of the stream.
+    template<Streams Stream>
+    using IStatTag = std::conditional_t<static_cast<uint32_t>(Stream) < 4, LISR_Tag, HISR_Tag>;
+
+    /// @brief Interrupt flag clear register tag (LIFCR/HIFCR) of the stream.
+    template<Streams Stream>
+    using IClrTag = std::conditional_t<static_cast<uint32_t>(Stream) < 4, LIFCR_Tag, HIFCR_Tag>;
+
+    template<Streams Stream>
+    using TxCompleteIStatMask    = StatusMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream, StatusFlag::TxComplete>;
+
+    template<Streams Stream>
+    using HalfTxIStatMask        = StatusMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream, StatusFlag::HalfTx>;
+
+    template<Streams Stream>
+    using TxErrIStatMask         = StatusMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream, StatusFlag::TxError>;
+
+    template<Streams Stream>
+    using DirectModeErrIStatMask = StatusMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream, StatusFlag::DirectModeError>;
+
+    template<Streams Stream>
+    using FifoErrIStatMask       = StatusMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream, StatusFlag::FifoError>;
+
+    template<Streams Stream>
+    using TxCompleteIClrMask     = StatusMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream, StatusFlag::TxComplete>;
+
+    template<Streams Stream>
+    using HalfTxIClrMask         = StatusMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream, StatusFlag::HalfTx>;
+
+    template<Streams Stream>
+    using TxErrIClrMask          = StatusMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream, StatusFlag::TxError>;
+
     template<Streams Stream>
-    using TxCompleteIStatMask = StatusMask<std::conditional_t<static_cast<uint32_t>(Stream) < 4, LISR_Tag, HISR_Tag>, reg::BitFieldAccessFlag::RO, Stream>;
+    using DirectModeErrIClrMask  = StatusMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream, StatusFlag::DirectModeError>;
 
     template<Streams Stream>
-    using TxCompleteIClrMask = StatusMask<std::conditional_t<static_cast<uint32_t>(Stream) < 4, LIFCR_Tag, HIFCR_Tag>, reg::BitFieldAccessFlag::WO, Stream>;
+    using FifoErrIClrMask        = StatusMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream, StatusFlag::FifoError>;
+
+    /**
+     * @brief Composite mask of all stream flags, for status reading or clearing.
+     *
+     * @tparam Tag    LISR/HISR or LIFCR/HIFCR tag.
+     * @tparam Stream Stream number.
+     */
+    template<typename Tag, reg::BitFieldAccessFlag AccessFlag, Streams Stream>
+    constexpr RegisterMask<Tag, AccessFlag, 32, 0, uint32_t, true> AllFlagsMask()
+    {
+        return StatusMask<Tag, AccessFlag, Stream, StatusFlag::FifoError>()
+             | StatusMask<Tag, AccessFlag, Stream, StatusFlag::DirectModeError>()
+             | StatusMask<Tag, AccessFlag, Stream, StatusFlag::TxError>()
+             | StatusMask<Tag, AccessFlag, Stream, StatusFlag::HalfTx>()
+             | StatusMask<Tag, AccessFlag, Stream, StatusFlag::TxComplete>();
+    }
+
+    template<Streams Stream>
+    constexpr auto AllFlagsIStatMask() { return AllFlagsMask<IStatTag<Stream>, reg::BitFieldAccessFlag::RO, Stream>(); }
+
+    template<Streams Stream>
+    constexpr auto AllFlagsIClrMask() { return AllFlagsMask<IClrTag<Stream>, reg::BitFieldAccessFlag::WO, Stream>(); }
 
     using StreamEnableMask     = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 1, 0, bool>;
     using DirectModeErrIEnMask = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 1, 1, bool>;
@@ -141,6 +227,10 @@ namespace dma
     using PeriphDataSizeMask   = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 2, 11, DataSize>;
     using MemDataSizeMask      = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 2, 13, DataSize>;
     using PriorityLvlMask      = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 2, 16, PriorityLevel>;
+    using DoubleBufferModeMask = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 1, 18, bool>;
+    using CurrentTargetMask    = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 1, 19, CurrentTarget>;
+    using PeriphBurstMask      = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 2, 21, BurstSize>;
+    using MemBurstMask         = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 2, 23, BurstSize>;
     using ChannelSelMask       = RegisterMask<SxCR_Tag, reg::BitFieldAccessFlag::RW, 3, 25, Channels>;
 
     using NumOfDataMask        = RegisterMask<SxNDTR_Tag, reg::BitFieldAccessFlag::RW, 16, 0, uint16_t>;
@@ -154,6 +244,228 @@ namespace dma
     using FifoStatusMask       = RegisterMask<SxFCR_Tag, reg::BitFieldAccessFlag::RO, 3, 3, FifoStatus>;
     using FifoErrIEnMask       = RegisterMask<SxFCR_Tag, reg::BitFieldAccessFlag::RW, 1, 7, bool>;
 
+    /**
+     * @brief DMA requests of STM32F411 peripherals.
+     */
+    enum class Request : uint8_t
+    {
+        Adc1,
+        Sdio,
+        Spi1Rx,
+        Spi1Tx,
+        Spi2Rx,
+        Spi2Tx,
+        Spi3Rx,
+        Spi3Tx,
+        Spi4Rx,
+        Spi4Tx,
+        Spi5Rx,
+        Spi5Tx,
+        I2s2ExtRx,
+        I2s2ExtTx,
+        I2s3ExtRx,
+        I2s3ExtTx,
+        Usart1Rx,
+        Usart1Tx,
+        Usart2Rx,
+        Usart2Tx,
+        Usart6Rx,
+        Usart6Tx,
+        I2c1Rx,
+        I2c1Tx,
+        I2c2Rx,
+        I2c2Tx,
+        I2c3Rx,
+        I2c3Tx,
+        Tim1Ch1,
+        Tim1Ch2,
+        Tim1Ch3,
+        Tim1Ch4,
+        Tim1Up,
+        Tim1Trig,
+        Tim1Com,
+        Tim2Ch1,
+        Tim2Ch2,
+        Tim2Ch3,
+        Tim2Ch4,
+        Tim2Up,
+        Tim3Ch1,
+        Tim3Ch2,
+        Tim3Ch3,
+        Tim3Ch4,
+        Tim3Up,
+        Tim3Trig,
+        Tim4Ch1,
+        Tim4Ch2,
+        Tim4Ch3,
+        Tim4Up,
+        Tim5Ch1,
+        Tim5Ch2,
+        Tim5Ch3,
+        Tim5Ch4,
+        Tim5Up,
+        Tim5Trig
+    };
+
+    /**
+     * @brief Single cell of the DMA request mapping.
+     */
+    struct RequestRoute
+    {
+        Peripherals periph;
+        Streams stream;
+        Channels channel;
+        Request request;
+    };
+
+    /**
+     * @brief DMA1/DMA2 request mapping of STM32F411 (reference manual RM0383, tables 27 and 28).
+     */
+    constexpr RequestRoute RequestMapping[] =
+    {
+        // Dma1
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_0, Request::Spi3Rx},
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_1, Request::I2c1Rx},
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_2, Request::Tim4Ch1},
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_3, Request::I2s3ExtRx},
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_6, Request::Tim5Ch3},
+        {Peripherals::Dma_1, Streams::Stream_0, Channels::Ch_6, Request::Tim5Up},
+        {Peripherals::Dma_1, Streams::Stream_1, Channels::Ch_1, Request::I2c3Rx},
+        {Peripherals::Dma_1, Streams::Stream_1, Channels::Ch_3, Request::Tim2Up},
+        {Peripherals::Dma_1, Streams::Stream_1, Channels::Ch_3, Request::Tim2Ch3},
+        {Peripherals::Dma_1, Streams::Stream_1, Channels::Ch_6, Request::Tim5Ch4},
+        {Peripherals::Dma_1, Streams::Stream_1, Channels::Ch_6, Request::Tim5Trig},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_0, Request::Spi3Rx},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_2, Request::I2s3ExtRx},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_3, Request::I2c3Rx},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_5, Request::Tim3Ch4},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_5, Request::Tim3Up},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_6, Request::Tim5Ch1},
+        {Peripherals::Dma_1, Streams::Stream_2, Channels::Ch_7, Request::I2c2Rx},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_0, Request::Spi2Rx},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_2, Request::Tim4Ch2},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_3, Request::I2s2ExtRx},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_6, Request::Tim5Ch4},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_6, Request::Tim5Trig},
+        {Peripherals::Dma_1, Streams::Stream_3, Channels::Ch_7, Request::I2c2Rx},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_0, Request::Spi2Tx},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_2, Request::I2s2ExtTx},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_3, Request::I2c3Tx},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_5, Request::Tim3Ch1},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_5, Request::Tim3Trig},
+        {Peripherals::Dma_1, Streams::Stream_4, Channels::Ch_6, Request::Tim5Ch2},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_0, Request::Spi3Tx},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_1, Request::I2c1Rx},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_2, Request::I2s3ExtTx},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_3, Request::Tim2Ch1},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_4, Request::Usart2Rx},
+        {Peripherals::Dma_1, Streams::Stream_5, Channels::Ch_5, Request::Tim3Ch2},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_1, Request::I2c1Tx},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_2, Request::Tim4Up},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_3, Request::Tim2Ch2},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_3, Request::Tim2Ch4},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_4, Request::Usart2Tx},
+        {Peripherals::Dma_1, Streams::Stream_6, Channels::Ch_6, Request::Tim5Up},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_0, Request::Spi3Tx},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_1, Request::I2c1Tx},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_2, Request::Tim4Ch3},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_3, Request::Tim2Up},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_3, Request::Tim2Ch4},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_5, Request::Tim3Ch3},
+        {Peripherals::Dma_1, Streams::Stream_7, Channels::Ch_7, Request::I2c2Tx},
+        // Dma2
+        {Peripherals::Dma_2, Streams::Stream_0, Channels::Ch_0, Request::Adc1},
+        {Peripherals::Dma_2, Streams::Stream_0, Channels::Ch_3, Request::Spi1Rx},
+        {Peripherals::Dma_2, Streams::Stream_0, Channels::Ch_4, Request::Spi4Rx},
+        {Peripherals::Dma_2, Streams::Stream_0, Channels::Ch_6, Request::Tim1Trig},
+        {Peripherals::Dma_2, Streams::Stream_1, Channels::Ch_4, Request::Spi4Tx},
+        {Peripherals::Dma_2, Streams::Stream_1, Channels::Ch_5, Request::Usart6Rx},
+        {Peripherals::Dma_2, Streams::Stream_1, Channels::Ch_6, Request::Tim1Ch1},
+        {Peripherals::Dma_2, Streams::Stream_2, Channels::Ch_3, Request::Spi1Rx},
+        {Peripherals::Dma_2, Streams::Stream_2, Channels::Ch_4, Request::Usart1Rx},
+        {Peripherals::Dma_2, Streams::Stream_2, Channels::Ch_5, Request::Usart6Rx},
+        {Peripherals::Dma_2, Streams::Stream_2, Channels::Ch_6, Request::Tim1Ch2},
+        {Peripherals::Dma_2, Streams::Stream_3, Channels::Ch_2, Request::Spi5Rx},
+        {Peripherals::Dma_2, Streams::Stream_3, Channels::Ch_3, Request::Spi1Tx},
+        {Peripherals::Dma_2, Streams::Stream_3, Channels::Ch_4, Request::Sdio},
+        {Peripherals::Dma_2, Streams::Stream_3, Channels::Ch_5, Request::Spi4Rx},
+        {Peripherals::Dma_2, Streams::Stream_3, Channels::Ch_6, Request::Tim1Ch1},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_0, Request::Adc1},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_2, Request::Spi5Tx},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_5, Request::Spi4Tx},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_6, Request::Tim1Ch4},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_6, Request::Tim1Trig},
+        {Peripherals::Dma_2, Streams::Stream_4, Channels::Ch_6, Request::Tim1Com},
+        {Peripherals::Dma_2, Streams::Stream_5, Channels::Ch_3, Request::Spi1Tx},
+        {Peripherals::Dma_2, Streams::Stream_5, Channels::Ch_4, Request::Usart1Rx},
+        {Peripherals::Dma_2, Streams::Stream_5, Channels::Ch_5, Request::Spi5Tx},
+        {Peripherals::Dma_2, Streams::Stream_5, Channels::Ch_6, Request::Tim1Up},
+        {Peripherals::Dma_2, Streams::Stream_5, Channels::Ch_7, Request::Spi5Rx},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_0, Request::Tim1Ch1},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_0, Request::Tim1Ch2},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_0, Request::Tim1Ch3},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_4, Request::Sdio},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_5, Request::Usart6Tx},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_6, Request::Tim1Ch3},
+        {Peripherals::Dma_2, Streams::Stream_6, Channels::Ch_7, Request::Spi5Tx},
+        {Peripherals::Dma_2, Streams::Stream_7, Channels::Ch_4, Request::Usart1Tx},
+        {Peripherals::Dma_2, Streams::Stream_7, Channels::Ch_5, Request::Usart6Tx}
+    };
+
+    /**
+     * @brief Checks whether any peripheral request is mapped to the stream and channel.
+     */
+    constexpr bool is_mapped(Peripherals periph, Streams stream, Channels channel)
+    {
+        for (const auto& route : RequestMapping)
+        {
+            if (route.periph == periph && route.stream == stream && route.channel == channel)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks whether the request can be served by the stream of the given DMA.
+     */
+    constexpr bool is_mapped(Request request, Peripherals periph, Streams stream)
+    {
+        for (const auto& route : RequestMapping)
+        {
+            if (route.request == request && route.periph == periph && route.stream == stream)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Looks up the DMA and channel serving the request on the given stream.
+     *
+     * Fails to compile if the request is not mapped to the stream.
+     *
+     * @tparam Req    Peripheral request.
+     * @tparam Stream Stream number.
+     */
+    template<Request Req, Streams Stream>
+    struct RouteOf
+    {
+        private:
+            static constexpr const RequestRoute* find()
+            {
+                for (const auto& route : RequestMapping)
+                {
+                    if (route.request == Req && route.stream == Stream)
+                        return &route;
+                }
+                return nullptr;
+            }
+
+        public:
+            static_assert(find() != nullptr, "DMA request is not mapped to this stream");
+
+            static constexpr Peripherals periph = find()->periph;
+            static constexpr Channels channel = find()->channel;
+    };
 };
 
 /**
@@ -174,6 +486,14 @@ class DmaRegs
         using LowIClearReg  = Register<dma::LIFCR_Tag, BASE_ADDR + 0x08>;
         using HighIClearReg = Register<dma::HIFCR_Tag, BASE_ADDR + 0x0C>;
 
+        /// @brief Interrupt status register (LISR/HISR) holding flags of the stream.
+        template<dma::Streams Stream>
+        using IStatReg  = std::conditional_t<(static_cast<uint8_t>(Stream) < 4), LowIStatReg, HighIStatReg>;
+
+        /// @brief Interrupt flag clear register (LIFCR/HIFCR) holding flags of the stream.
+        template<dma::Streams Stream>
+        using IClearReg = std::conditional_t<(static_cast<uint8_t>(Stream) < 4), LowIClearReg, HighIClearReg>;
+
         template<dma::Streams Stream>
         using ConfigReg     = Register<dma::SxCR_Tag, BASE_ADDR + 0x10 + static_cast<uint32_t>(Stream) * 0x18>;
 
@@ -191,7 +511,23 @@ class DmaRegs
 
         template<dma::Streams Stream>
         using FifoControlReg  = Register<dma::SxFCR_Tag, BASE_ADDR + 0x24 + static_cast<uint32_t>(Stream) * 0x18>;
+
+        /**
+         * @brief Acknowledges every flag (TC, HT, TE, DME, FE) of the stream with one write.
+         *
+         * @tparam Stream Stream number.
+         * @return `StatusCode`.
+         */
+        template<dma::Streams Stream>
+        static inline StatusCode clear_all()
+        {
+            return IClearReg<Stream>::write(dma::AllFlagsIClrMask<Stream>());
+        }
 };
 
 
+// Bit-band alias of every DMA base, values as computed by the reference manual formula
+static_assert(DmaRegs<dma::Peripherals::Dma_1>::LowIStatReg::bit_band_addr<0>() == 0x424C0000UL, "DMA1 bit-band alias mismatch");
+static_assert(DmaRegs<dma::Peripherals::Dma_2>::LowIStatReg::bit_band_addr<0>() == 0x424C8000UL, "DMA2 bit-band alias mismatch");
+
 #endif
@@ -0,0 +1,324 @@
+#ifndef _DMASTREAM_HPP_
+#define _DMASTREAM_HPP_
+
+#include "dma_regs.hpp"
+
+#include <cstdint>
+#include <stdint.h>
+#include <type_traits>
+
+namespace dma
+{
+    /**
+     * @brief Stream transfer configuration, translated to SxCR and SxFCR values.
+     */
+    struct StreamConfig
+    {
+        TransferDirection direction{TransferDirection::PeriphToMem};
+        DataSize periph_size{DataSize::Byte};
+        DataSize mem_size{DataSize::Byte};
+        AddrIncrementMode periph_incr{AddrIncrementMode::AddrPtrFixed};
+        AddrIncrementMode mem_incr{AddrIncrementMode::AddrPtrIncr};
+        PriorityLevel priority{PriorityLevel::Low};
+        bool circular{false};
+        bool tx_complete_irq{false};
+        bool half_tx_irq{false};
+        bool tx_error_irq{false};
+        bool fifo{false};                                ///< FIFO mode instead of direct mode
+        FifoThreshold fifo_threshold{FifoThreshold::Full_50};
+        BurstSize periph_burst{BurstSize::Single};       ///< Requires FIFO mode
+        BurstSize mem_burst{BurstSize::Single};          ///< Requires FIFO mode
+    };
+};
+
+/**
+ * @brief DMA stream driver.
+ *
+ * Static class.
+ *
+ * The stream/channel pair is validated against the F411 request mapping at compile time.
+ * Memory-to-memory streams need no request and are declared explicitly with `MemToMem`
+ * (see `DmaMemStream`), only DMA2 can run them.
+ * SxCR is configured with a single store and enabled with a single bit-band store.
+ *
+ * @tparam Periph   DMA peripheral (DMA1, DMA2).
+ * @tparam Stream   Stream number.
+ * @tparam Channel  Channel selecting the peripheral request.
+ * @tparam MemToMem Stream runs memory-to-memory transfers only.
+ */
+template<dma::Peripherals Periph, dma::Streams Stream, dma::Channels Channel, bool MemToMem = false>
+class DmaStream
+{
+    static_assert(MemToMem || dma::is_mapped(Periph, Stream, Channel),
+                  "No DMA request is mapped to this stream and channel");
+    static_assert(!MemToMem || Periph == dma::Peripherals::Dma_2,
+                  "Memory-to-memory transfers are only supported by DMA2");
+
+    private:
+        using Regs = DmaRegs<Periph>;
+
+        using IStatReg  = typename Regs::template IStatReg<Stream>;
+        using IClearReg = typename Regs::template IClearReg<Stream>;
+
+        using ConfigReg      = typename Regs::template ConfigReg<Stream>;
+        using NumOfDataReg   = typename Regs::template NumOfDataReg<Stream>;
+        using PeriphAddrReg  = typename Regs::template PeriphAddrReg<Stream>;
+        using Mem0AddrReg    = typename Regs::template Mem0AddrReg<Stream>;
+        using Mem1AddrReg    = typename Regs::template Mem1AddrReg<Stream>;
+        using FifoControlReg = typename Regs::template FifoControlReg<Stream>;
+
+    public:
+        DmaStream() = delete;
+
+        /**
+         * @brief Computes SxCR value for the configuration, stream stays disabled.
+         *
+         * @param config Transfer configuration.
+         * @return SxCR value.
+         */
+        static constexpr uint32_t control_value(const dma::StreamConfig& config)
+        {
+            return dma::ChannelSelMask(Channel)
+                 | dma::TxDirectionMask(config.direction)
+                 | dma::PeriphDataSizeMask(config.periph_size)
+                 | dma::MemDataSizeMask(config.mem_size)
+                 | dma::PeriphIncrModeMask(config.periph_incr)
+                 | dma::MemIncrModeMask(config.mem_incr)
+                 | dma::PriorityLvlMask(config.priority)
+                 | dma::CircularModeMask(config.circular)
+                 | dma::TxIEnableMask(config.tx_complete_irq)
+                 | dma::HalfTxIEnableMask(config.half_tx_irq)
+                 | dma::TxErrIEnableMask(config.tx_error_irq)
+                 | dma::PeriphBurstMask(config.periph_burst)
+                 | dma::MemBurstMask(config.mem_burst);
+        }
+
+        /**
+         * @brief Computes SxFCR value for the configuration.
+         *
+         * @param config Transfer configuration.
+         * @return SxFCR value.
+         */
+        static constexpr uint32_t fifo_value(const dma::StreamConfig& config)
+        {
+            return dma::DirectModeDisMask(config.fifo) | dma::FifoThresholdMask(config.fifo_threshold);
+        }
+
+        /**
+         * @brief Configures and starts a transfer.
+         *
+         * Any running transfer is aborted and stream flags are cleared first.
+         * For peripheral-to-memory and memory-to-memory `src` goes to SxPAR and `dst` to SxM0AR,
+         * for memory-to-peripheral it is the other way around.
+         *
+         * @param config Transfer configuration.
+         * @param src    Source address.
+         * @param dst    Destination address.
+         * @param count  Number of data items (in peripheral data size units).
+         * @return `StatusCode::Error` if the direction does not match the stream kind.
+         */
+        static inline StatusCode start(const dma::StreamConfig& config, uint32_t src, uint32_t dst, uint16_t count)
+        {
+            if ((config.direction == dma::TransferDirection::MemToMem) != MemToMem)
+                return StatusCode::Error;
+
+            abort();
+            clear_flags();
+
+            const bool to_periph = (config.direction == dma::TransferDirection::MemToPeriph);
+            PeriphAddrReg::write(dma::PeriphAddrMask(to_periph ? dst : src));
+            Mem0AddrReg::write(dma::Mem0AddrMask(to_periph ? src : dst));
+            NumOfDataReg::write(dma::NumOfDataMask(count));
+            FifoControlReg::write(RegisterMask<dma::SxFCR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{fifo_value(config)});
+            ConfigReg::write(RegisterMask<dma::SxCR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{control_value(config)});
+
+            return ConfigReg::set(dma::StreamEnableMask(true));
+        }
+
+        /**
+         * @brief Configures and starts a transfer between two objects in memory or peripheral registers.
+         *
+         * @param config Transfer configuration.
+         * @param src    Source pointer.
+         * @param dst    Destination pointer.
+         * @param count  Number of data items (in peripheral data size units).
+         * @return `StatusCode`.
+         */
+        static inline StatusCode start(const dma::StreamConfig& config, const volatile void* src, volatile void* dst, uint16_t count)
+        {
+            return start(config, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(src)), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(dst)), count);
+        }
+
+        /**
+         * @brief Configures and starts a double-buffer (ping-pong) transfer.
+         *
+         * Hardware alternates between memory 0 and memory 1 and never stops, circular mode
+         * is implied. While hardware fills one buffer, the other one is owned by the application
+         * and can be replaced with `set_idle_buffer()` without stopping the stream.
+         * Memory-to-memory direction is not supported by hardware in this mode.
+         *
+         * @param config      Transfer configuration.
+         * @param periph_addr Peripheral register address.
+         * @param mem0        Address of the first memory buffer.
+         * @param mem1        Address of the second memory buffer.
+         * @param count       Number of data items per buffer.
+         * @return `StatusCode`.
+         */
+        static inline StatusCode start_double_buffer(const dma::StreamConfig& config, uint32_t periph_addr, uint32_t mem0, uint32_t mem1, uint16_t count)
+        {
+            static_assert(!MemToMem, "Double-buffer mode needs a peripheral request");
+            if (config.direction == dma::TransferDirection::MemToMem)
+                return StatusCode::Error;
+
+            abort();
+            clear_flags();
+
+            PeriphAddrReg::write(dma::PeriphAddrMask(periph_addr));
+            Mem0AddrReg::write(dma::Mem0AddrMask(mem0));
+            Mem1AddrReg::write(dma::Mem1AddrMask(mem1));
+            NumOfDataReg::write(dma::NumOfDataMask(count));
+            FifoControlReg::write(RegisterMask<dma::SxFCR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{fifo_value(config)});
+            ConfigReg::write(dma::DoubleBufferModeMask(true) | dma::CircularModeMask(true)
+                           | RegisterMask<dma::SxCR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{control_value(config)});
+
+            return ConfigReg::set(dma::StreamEnableMask(true));
+        }
+
+        /**
+         * @brief Configures and starts a double-buffer transfer on two memory buffers.
+         *
+         * @param config Transfer configuration.
+         * @param periph Peripheral register.
+         * @param mem0   First memory buffer.
+         * @param mem1   Second memory buffer.
+         * @param count  Number of data items per buffer.
+         * @return `StatusCode`.
+         */
+        static inline StatusCode start_double_buffer(const dma::StreamConfig& config, const volatile void* periph, volatile void* mem0, volatile void* mem1, uint16_t count)
+        {
+            return start_double_buffer(config, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(periph)),
+                                       static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mem0)),
+                                       static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mem1)), count);
+        }
+
+        /// @brief Returns memory buffer currently owned by hardware in double-buffer mode.
+        static inline dma::CurrentTarget current_target()
+        {
+            // Field is read back in register position
+            return ConfigReg::read(dma::CurrentTargetMask()).value ? dma::CurrentTarget::Memory_1 : dma::CurrentTarget::Memory_0;
+        }
+
+        /**
+         * @brief Replaces address of the buffer not owned by hardware, stream keeps running.
+         *
+         * Call it from the transfer complete interrupt, well before hardware switches buffers again.
+         * Writing the buffer in use makes hardware disable the stream and raise the transfer error flag.
+         *
+         * @param addr New buffer address.
+         * @return Buffer that was replaced.
+         */
+        static inline dma::CurrentTarget set_idle_buffer(uint32_t addr)
+        {
+            if (current_target() == dma::CurrentTarget::Memory_0)
+            {
+                Mem1AddrReg::write(dma::Mem1AddrMask(addr));
+                return dma::CurrentTarget::Memory_1;
+            }
+
+            Mem0AddrReg::write(dma::Mem0AddrMask(addr));
+            return dma::CurrentTarget::Memory_0;
+        }
+
+        /// @brief Replaces the buffer not owned by hardware, see `set_idle_buffer(uint32_t)`.
+        static inline dma::CurrentTarget set_idle_buffer(volatile void* buffer)
+        {
+            return set_idle_buffer(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer)));
+        }
+
+        /**
+         * @brief Disables the stream and waits until the hardware releases it.
+         *
+         * @return `StatusCode`.
+         */
+        static inline StatusCode abort()
+        {
+            ConfigReg::clear(dma::StreamEnableMask(true));
+            while (is_enabled());
+
+            return StatusCode::Ok;
+        }
+
+        /// @brief Returns true while the stream is enabled.
+        static inline bool is_enabled()
+        {
+            return ConfigReg::read(dma::StreamEnableMask()).value;
+        }
+
+        /// @brief Returns true once the transfer complete flag is set.
+        static inline bool is_complete()
+        {
+            return IStatReg::read(dma::TxCompleteIStatMask<Stream>()).value;
+        }
+
+        /// @brief Returns number of data items still to be transferred.
+        static inline uint16_t remaining()
+        {
+            return static_cast<uint16_t>(NumOfDataReg::read(dma::NumOfDataMask()).value);
+        }
+
+        /// @brief Clears the transfer complete flag.
+        static inline StatusCode clear_complete()
+        {
+            return IClearReg::write(dma::TxCompleteIClrMask<Stream>());
+        }
+
+        /// @brief Returns true if transfer error flag is set.
+        static inline bool has_tx_error()
+        {
+            return IStatReg::read(dma::TxErrIStatMask<Stream>()).value;
+        }
+
+        /// @brief Returns true if transfer, direct mode or FIFO error flag is set.
+        static inline bool has_error()
+        {
+            return IStatReg::read(dma::TxErrIStatMask<Stream>() | dma::DirectModeErrIStatMask<Stream>() | dma::FifoErrIStatMask<Stream>()).value;
+        }
+
+        /**
+         * @brief Reads all flags of the stream with a single load.
+         *
+         * @return Flags shifted down, bit positions match `dma::StatusFlag`.
+         */
+        static inline uint32_t flags()
+        {
+            return IStatReg::read(dma::AllFlagsIStatMask<Stream>()).value >> dma::StatusGroupPos[static_cast<uint8_t>(Stream)];
+        }
+
+        /// @brief Clears every flag of the stream with a single store.
+        static inline StatusCode clear_flags()
+        {
+            return Regs::template clear_all<Stream>();
+        }
+};
+
+/**
+ * @brief DMA stream serving the given peripheral request.
+ *
+ * DMA peripheral and channel are taken from the request mapping,
+ * a request that is not mapped to the stream fails to compile.
+ *
+ * @tparam Req    Peripheral request.
+ * @tparam Stream Stream number.
+ */
+template<dma::Request Req, dma::Streams Stream>
+using DmaRequestStream = DmaStream<dma::RouteOf<Req, Stream>::periph, Stream, dma::RouteOf<Req, Stream>::channel>;
+
+/**
+ * @brief DMA2 stream dedicated to memory-to-memory transfers.
+ *
+ * @tparam Stream Stream number.
+ */
+template<dma::Streams Stream>
+using DmaMemStream = DmaStream<dma::Peripherals::Dma_2, Stream, dma::Channels::Ch_0, true>;
+
+#endif
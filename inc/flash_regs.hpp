@@ -21,7 +21,12 @@ namespace flash
         WaitState_6
     };
 
-    using LatencyMask = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 4, 0, Latency>;
+    using LatencyMask        = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 4, 0,  Latency>;
+    using PrefetchEnableMask = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 1, 8,  bool>;
+    using InstrCacheEnMask   = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 1, 9,  bool>;
+    using DataCacheEnMask    = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 1, 10, bool>;
+    using InstrCacheRstMask  = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 1, 11, bool>;
+    using DataCacheRstMask   = RegisterMask<ACR_Tag, reg::BitFieldAccessFlag::RW, 1, 12, bool>;
 };
 
 /**
@@ -38,4 +43,53 @@ class FlashRegs
        
        using AccessControlReg = Register<flash::ACR_Tag, BASE_ADDR + 0x00>;
 };
+
+/**
+ * @brief FLASH interface control.
+ *
+ * Static class.
+ */
+class Flash
+{
+    public:
+        Flash() = delete;
+
+        /**
+         * @brief Resets and enables ART accelerator: instruction cache, data cache and prefetch.
+         *
+         * Caches may be reset only while disabled, so they are disabled first, reset, released
+         * from reset and then enabled together with prefetch. Latency is left untouched.
+         *
+         * @return `StatusCode`.
+         */
+        static StatusCode enable_art()
+        {
+            FlashRegs::AccessControlReg::clear(flash::InstrCacheEnMask(true) | flash::DataCacheEnMask(true));
+            FlashRegs::AccessControlReg::set(flash::InstrCacheRstMask(true) | flash::DataCacheRstMask(true));
+            FlashRegs::AccessControlReg::clear(flash::InstrCacheRstMask(true) | flash::DataCacheRstMask(true));
+
+            return FlashRegs::AccessControlReg::set(flash::PrefetchEnableMask(true) | flash::InstrCacheEnMask(true) | flash::DataCacheEnMask(true));
+        }
+
+        /**
+         * @brief Disables ART accelerator, flash is then read with the configured wait states on every access.
+         *
+         * @return `StatusCode`.
+         */
+        static StatusCode disable_art()
+        {
+            return FlashRegs::AccessControlReg::clear(flash::PrefetchEnableMask(true) | flash::InstrCacheEnMask(true) | flash::DataCacheEnMask(true));
+        }
+
+        /// @brief Returns true if both caches and prefetch are enabled.
+        static bool is_art_enabled()
+        {
+            constexpr uint32_t art = flash::PrefetchEnableMask(true) | flash::InstrCacheEnMask(true) | flash::DataCacheEnMask(true);
+            return FlashRegs::AccessControlReg::read(RegisterMask<flash::ACR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{art}).value == art;
+        }
+};
+
+// Bit-band alias of FLASH interface base, value as computed by the reference manual formula
+static_assert(FlashRegs::AccessControlReg::bit_band_addr<0>() == 0x42478000UL, "FLASH bit-band alias mismatch");
+
 #endif
\ No newline at end of file
@@ -159,7 +159,7 @@ namespace gpio
          * @param val value to apply for that pin.
          */
         constexpr PinMask(ValueType val)
-            : RegisterMask<Tag, AccessFlag, Width, static_cast<uint8_t>(Pin) * Width> {static_cast<uint32_t>(val)} 
+            : RegisterMask<Tag, AccessFlag, Width, static_cast<uint8_t>(Pin) * Width + PosOffset> {static_cast<uint32_t>(val)} 
             {
                 if constexpr (std::is_same_v<Tag, gpio::AFRL_Tag>)
                     static_assert(static_cast<uint8_t>(Pin) < 8, "Alternate function LOW register accepts 0-7 pins only!");
@@ -175,7 +175,7 @@ namespace gpio
          * @param pin GPIO pin number.
          */
         constexpr PinMask()
-            : RegisterMask<Tag, AccessFlag, Width, static_cast<uint8_t>(Pin) * Width> {((1U << Width) - 1)} {}
+            : RegisterMask<Tag, AccessFlag, Width, static_cast<uint8_t>(Pin) * Width + PosOffset> {((1U << Width) - 1)} {}
     };
 
     /// @brief GPIO mode mask (MODER register, 2 bits per pin).
@@ -204,11 +204,11 @@ namespace gpio
 
     /// @brief GPIO bit set mask (BSRR register, 1 bit per pin).
     template<Pins Pin>
-    using BitSetMask = PinMask<gpio::BSRR_Tag, reg::BitFieldAccessFlag::RW, 1, bool, Pin>;
-    /// @brief GPIO bit reset mask (BSRR register, 1 bit per pin).
+    using BitSetMask = PinMask<gpio::BSRR_Tag, reg::BitFieldAccessFlag::WO, 1, bool, Pin>;
 
+    /// @brief GPIO bit reset mask (BSRR register, 1 bit per pin, starting at bit 16).
     template<Pins Pin>
-    using BitResetMask = PinMask<gpio::BSRR_Tag, reg::BitFieldAccessFlag::RW, 1, bool, Pin, 16>;
+    using BitResetMask = PinMask<gpio::BSRR_Tag, reg::BitFieldAccessFlag::WO, 1, bool, Pin, 16>;
 
     /*
         TODO: Implement LockMask and Lock register
@@ -271,4 +271,202 @@ class GpioRegs
         using AltFuncHighReg    = Register<gpio::AFRH_Tag,    BASE_ADDR + 0x24>;
 };
 
+namespace gpio
+{
+    /// @brief Composite mask covering any pins of a GPIO register.
+    template<typename Tag>
+    using PortMask = RegisterMask<Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>;
+
+    /// @brief Composite mask covering any set/reset bits of BSRR.
+    using BitSetResetPortMask = RegisterMask<BSRR_Tag, reg::BitFieldAccessFlag::WO, 32, 0, uint32_t, true>;
+
+    /**
+     * @brief Compile-time set of pins configured together.
+     *
+     * All per-pin fields are combined at compile time, so configuring any number of pins
+     * costs one read-modify-write per register instead of one per pin.
+     * Alternate function values are split across AFRL and AFRH automatically.
+     *
+     * @tparam PinList Pins in the set, each pin may appear only once.
+     */
+    template<Pins... PinList>
+    struct PinSet
+    {
+        static_assert(sizeof...(PinList) > 0, "Pin set must contain at least one pin");
+        static_assert(reg::fields_disjoint<(1U << static_cast<uint8_t>(PinList))...>(), "Pin listed more than once in the pin set");
+
+        PinSet() = delete;
+
+        /// @brief Bit per pin in the set (ODR/IDR layout).
+        static constexpr uint16_t pins = (0U | ... | (1U << static_cast<uint8_t>(PinList)));
+
+        /// @brief Pins handled by AFRL (0-7).
+        static constexpr uint16_t low_pins  = pins & 0x00FFU;
+
+        /// @brief Pins handled by AFRH (8-15).
+        static constexpr uint16_t high_pins = pins & 0xFF00U;
+
+        /**
+         * @brief Replicates value into the field of every pin in the set.
+         *
+         * @tparam Width   Field width per pin.
+         * @tparam PinBase First pin of the register (8 for AFRH).
+         * @param value    Value of one field.
+         * @return Combined register value.
+         */
+        template<uint32_t Width, uint8_t PinBase = 0>
+        static constexpr uint32_t spread(uint32_t value)
+        {
+            uint32_t result = 0;
+            for (uint32_t pin = PinBase; pin < PinBase + 32 / Width; ++pin)
+            {
+                if (pins & (1U << pin))
+                    result |= (value & ((1U << Width) - 1)) << ((pin - PinBase) * Width);
+            }
+            return result;
+        }
+
+        /// @brief Configures mode of all pins with one MODER access.
+        template<Port P>
+        static inline StatusCode set_mode(Mode mode)
+        {
+            return GpioRegs<P>::ModeReg::modify(PortMask<MODER_Tag>{spread<2>(3U)}, PortMask<MODER_Tag>{spread<2>(static_cast<uint32_t>(mode))});
+        }
+
+        /// @brief Configures output type of all pins with one OTYPER access.
+        template<Port P>
+        static inline StatusCode set_output_type(OutputType type)
+        {
+            return GpioRegs<P>::OutputTypeReg::modify(PortMask<OTYPER_Tag>{spread<1>(1U)}, PortMask<OTYPER_Tag>{spread<1>(static_cast<uint32_t>(type))});
+        }
+
+        /// @brief Configures output speed of all pins with one OSPEEDR access.
+        template<Port P>
+        static inline StatusCode set_output_speed(OutputSpeed speed)
+        {
+            return GpioRegs<P>::OutputSpeedReg::modify(PortMask<OSPEEDR_Tag>{spread<2>(3U)}, PortMask<OSPEEDR_Tag>{spread<2>(static_cast<uint32_t>(speed))});
+        }
+
+        /// @brief Configures pull-up/pull-down of all pins with one PUPDR access.
+        template<Port P>
+        static inline StatusCode set_pull_type(PullType pull)
+        {
+            return GpioRegs<P>::PullTypeReg::modify(PortMask<PUPDR_Tag>{spread<2>(3U)}, PortMask<PUPDR_Tag>{spread<2>(static_cast<uint32_t>(pull))});
+        }
+
+        /**
+         * @brief Configures alternate function of all pins.
+         *
+         * AFRL and AFRH are each accessed once, and only if the set has pins in them.
+         */
+        template<Port P>
+        static inline StatusCode set_alt_func(AlternateFunc func)
+        {
+            if constexpr (low_pins != 0)
+                GpioRegs<P>::AltFuncLowReg::modify(PortMask<AFRL_Tag>{spread<4>(0xFU)}, PortMask<AFRL_Tag>{spread<4>(static_cast<uint32_t>(func))});
+            if constexpr (high_pins != 0)
+                GpioRegs<P>::AltFuncHighReg::modify(PortMask<AFRH_Tag>{spread<4, 8>(0xFU)}, PortMask<AFRH_Tag>{spread<4, 8>(static_cast<uint32_t>(func))});
+
+            return StatusCode::Ok;
+        }
+
+        /**
+         * @brief Configures all pins of the set, one access per register.
+         *
+         * Alternate function registers are written first, so pins switched to
+         * `Mode::AltFunc` never drive a stale function.
+         */
+        template<Port P>
+        static inline StatusCode configure(Mode mode, OutputType type = OutputType::PushPull, OutputSpeed speed = OutputSpeed::Low,
+                                           PullType pull = PullType::NoPull, AlternateFunc func = AlternateFunc::AF0)
+        {
+            if (mode == Mode::AltFunc)
+                set_alt_func<P>(func);
+            set_output_type<P>(type);
+            set_output_speed<P>(speed);
+            set_pull_type<P>(pull);
+
+            return set_mode<P>(mode);
+        }
+
+        /// @brief Drives all pins high with one BSRR store.
+        template<Port P>
+        static inline StatusCode set()
+        {
+            return GpioRegs<P>::BitSetResetReg::write(BitSetResetPortMask{pins});
+        }
+
+        /// @brief Drives all pins low with one BSRR store.
+        template<Port P>
+        static inline StatusCode reset()
+        {
+            return GpioRegs<P>::BitSetResetReg::write(BitSetResetPortMask{static_cast<uint32_t>(pins) << 16});
+        }
+
+        /**
+         * @brief Inverts all pins with one ODR read and one BSRR store.
+         *
+         * Other pins of the port are never written, so it is safe against ISRs
+         * driving other pins of the same port without disabling interrupts.
+         */
+        template<Port P>
+        static inline StatusCode toggle()
+        {
+            const uint32_t odr = GpioRegs<P>::OutputDataReg::read(PortMask<ODR_Tag>{pins});
+            return GpioRegs<P>::BitSetResetReg::write(BitSetResetPortMask{(~odr & pins) | (odr << 16)});
+        }
+
+        /**
+         * @brief Drives pins as a parallel bus with one BSRR store.
+         *
+         * Bit `i` of `value` is written to the `i`-th pin of `PinList`.
+         * Pins that are consecutive and ascending are mapped by a single shift.
+         *
+         * @param value Bus value, bits above the bus width are ignored.
+         */
+        template<Port P>
+        static inline StatusCode write_bus(uint16_t value)
+        {
+            const uint32_t high = scatter(value);
+            return GpioRegs<P>::BitSetResetReg::write(BitSetResetPortMask{high | (static_cast<uint32_t>(pins & ~high) << 16)});
+        }
+
+    private:
+        static constexpr uint8_t pin_list[] = {static_cast<uint8_t>(PinList)...};
+
+        static constexpr bool consecutive = []{
+            for (uint32_t i = 1; i < sizeof...(PinList); ++i)
+            {
+                if (pin_list[i] != pin_list[0] + i)
+                    return false;
+            }
+            return true;
+        }();
+
+        static constexpr uint32_t scatter(uint16_t value)
+        {
+            if constexpr (consecutive)
+            {
+                return (static_cast<uint32_t>(value) << pin_list[0]) & pins;
+            }
+            else
+            {
+                uint32_t result = 0;
+                uint32_t bit = 0;
+                ((result |= ((static_cast<uint32_t>(value) >> bit++) & 1U) << static_cast<uint8_t>(PinList)), ...);
+                return result;
+            }
+        }
+    };
+}
+
+// Bit-band alias of every port base, values as computed by the reference manual formula
+static_assert(GpioRegs<gpio::Port::A>::ModeReg::bit_band_addr<0>() == 0x42400000UL, "GPIOA bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::B>::ModeReg::bit_band_addr<0>() == 0x42480000UL, "GPIOB bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::C>::ModeReg::bit_band_addr<0>() == 0x42500000UL, "GPIOC bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::D>::ModeReg::bit_band_addr<0>() == 0x42580000UL, "GPIOD bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::E>::ModeReg::bit_band_addr<0>() == 0x42600000UL, "GPIOE bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::H>::ModeReg::bit_band_addr<0>() == 0x42780000UL, "GPIOH bit-band alias mismatch");
+static_assert(GpioRegs<gpio::Port::A>::OutputDataReg::bit_band_addr<5>() == 0x42400294UL, "GPIOA ODR5 bit-band alias mismatch");
+
 #endif
@@ -11,6 +11,8 @@ namespace pwr
 {
     struct CR_Tag {};
 
+    struct CSR_Tag {};
+
     enum class VoltageScalingOutSel : uint32_t
     {
         Default = 0U,
@@ -20,6 +22,8 @@ namespace pwr
     };
 
     using VoltageScalingOutSelMask = RegisterMask<CR_Tag, reg::BitFieldAccessFlag::RW, 2, 14, VoltageScalingOutSel>;
+
+    using VoltageScalingReadyMask  = RegisterMask<CSR_Tag, reg::BitFieldAccessFlag::RO, 1, 14, bool>;
 };
 
 /**
@@ -34,7 +38,11 @@ namespace pwr
      public:
         PowerCtrlRegs() = delete;
         
-        using ControlReg = Register<pwr::CR_Tag, BASE_ADDR + 0x00>;
+        using ControlReg = Register<pwr::CR_Tag,  BASE_ADDR + 0x00>;
+        using StatusReg  = Register<pwr::CSR_Tag, BASE_ADDR + 0x04>;
  };
 
+// Bit-band alias of PWR base, value as computed by the reference manual formula
+static_assert(PowerCtrlRegs::ControlReg::bit_band_addr<0>() == 0x420E0000UL, "PWR bit-band alias mismatch");
+
 #endif
\ No newline at end of file
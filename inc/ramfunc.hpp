@@ -0,0 +1,19 @@
+#ifndef _RAMFUNC_HPP_
+#define _RAMFUNC_HPP_
+
+/**
+ * @brief Places a function in the `.ramfunc` section, copied from FLASH to SRAM at boot.
+ *
+ * Code in SRAM runs without flash wait states or ART misses, use it for latency-critical
+ * interrupt handlers such as DMA completion and SPI. The function is never inlined so it keeps
+ * its section, calls between SRAM and FLASH go through linker veneers.
+ *
+ * Host simulation builds keep the function in regular code.
+ */
+#if defined(HAL_HOST_SIM)
+#define HAL_RAMFUNC
+#else
+#define HAL_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#endif
+
+#endif
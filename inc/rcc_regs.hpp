@@ -270,4 +270,7 @@ namespace rcc
         using Apb2EnableReg   = Register<rcc::APB2ENR_Tag,  BASE_ADDR + 0x44>;
  };
 
+// Bit-band alias of RCC base, value as computed by the reference manual formula
+static_assert(ResetClockCtrlRegs::ClockControlReg::bit_band_addr<0>() == 0x42470000UL, "RCC bit-band alias mismatch");
+
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _REGISTER_BASE_HPP_
 
 #include "./status_codes.hpp"
+#include "./bit_band.hpp"
 
 #include <cstdint>
 #include <stdint.h>
@@ -23,8 +24,55 @@ namespace reg
         RW,   ///< Read/Write
         RC_W0 ///< Read and Write 0 only
     };
+
+    /**
+     * @brief Register access backend for the MCU build.
+     *
+     * Plain volatile load/store on the memory mapped register, inlines to the same code
+     * as dereferencing the register address directly.
+     */
+    struct MmioAccess
+    {
+        /**
+         * @brief Reads the register at the given address.
+         *
+         * @param addr Register address.
+         * @return Register value.
+         */
+        static inline uint32_t load(uint32_t addr)
+        {
+            return *reinterpret_cast<volatile uint32_t*>(addr);
+        }
+
+        /**
+         * @brief Writes the register at the given address.
+         *
+         * @param addr  Register address.
+         * @param value Value to write.
+         */
+        static inline void store(uint32_t addr, uint32_t value)
+        {
+            *reinterpret_cast<volatile uint32_t*>(addr) = value;
+        }
+    };
 }
 
+#if defined(HAL_HOST_SIM)
+#include "./register_sim.hpp"
+
+namespace reg
+{
+    /// @brief Default access backend, simulated register file on host builds.
+    using DefaultAccess = sim::SimAccess;
+}
+#else
+namespace reg
+{
+    /// @brief Default access backend, memory mapped registers on MCU builds.
+    using DefaultAccess = MmioAccess;
+}
+#endif
+
 /**
  * @brief Base RegisterMask that is used to construct other masks.
  *
@@ -48,6 +96,12 @@ struct RegisterMask
     /// @brief Whether this is a composite mask created by combining other masks.
     static constexpr bool is_composite = IsComposite;
 
+    /// @brief Register tag the mask belongs to.
+    using tag_type = Tag;
+
+    /// @brief Bits covered by the field, independent of the value held.
+    static constexpr uint32_t field_mask = ((Width < 32) ? ((1U << Width) - 1) : ~0U) << Position;
+
     /**
      * @brief Constructs a register mask from the value.
      *
@@ -65,7 +119,7 @@ struct RegisterMask
      *
      */
      constexpr RegisterMask()
-     : value{(((Width < 32) ? ((1U << Width) - 1) : ~0UL)) << Position} {}
+     : value{(((Width < 32) ? ((1U << Width) - 1) : ~0U)) << Position} {}
 
     /**
      * @brief Combine two RegisterMask objects using bitwise OR.
@@ -142,6 +196,100 @@ struct RegisterMask
     }
 };
 
+namespace reg
+{
+    /**
+     * @brief Checks at compile time that no two field masks share a bit.
+     *
+     * @tparam FieldMasks Field masks to check.
+     * @return true if all fields are disjoint.
+     */
+    template<uint32_t... FieldMasks>
+    constexpr bool fields_disjoint()
+    {
+        uint32_t covered = 0;
+        bool disjoint = true;
+        ((disjoint = disjoint && ((covered & FieldMasks) == 0), covered |= FieldMasks), ...);
+        return disjoint;
+    }
+
+    /// @brief Tag selecting constructors that take an already combined raw value.
+    struct RawValueTag {};
+
+    /**
+     * @brief Register shadow that gathers field writes and commits them in one access.
+     *
+     * Field layout is known at compile time, so the combined clear mask is a constant.
+     * Only the set mask is built from field values. Commit costs one read and one write
+     * no matter how many fields are gathered.
+     *
+     * Constraints (checked with `static_assert`):
+     *   - All fields must belong to the register (`Reg::tag_type`)
+     *   - No read-only or composite fields
+     *   - Fields must not overlap
+     *
+     * @tparam Reg    Register the transaction is committed to.
+     * @tparam Fields Field mask types gathered so far.
+     */
+    template<typename Reg, typename... Fields>
+    class Transaction
+    {
+        static_assert((std::is_same_v<typename Fields::tag_type, typename Reg::tag_type> && ...), "Mismatched tags");
+        static_assert(((Fields::access_flag != BitFieldAccessFlag::RO) && ...), "Trying to modify a read-only field");
+        static_assert(((Fields::access_flag != BitFieldAccessFlag::RC_W0) && ...), "rc_w0 fields are cleared with Register::clear()");
+        static_assert((!Fields::is_composite && ...), "Composite masks have no field width, add fields one by one");
+        static_assert(fields_disjoint<Fields::field_mask...>(), "Overlapping fields in one transaction");
+
+        template<typename, typename...>
+        friend class Transaction;
+
+        using RawMask = RegisterMask<typename Reg::tag_type, BitFieldAccessFlag::RW, 32, 0, uint32_t, true>;
+
+        uint32_t set_mask{};
+
+        constexpr Transaction(RawValueTag, uint32_t mask) : set_mask{mask} {}
+
+        public:
+            /// @brief Bits of all gathered fields, cleared on commit.
+            static constexpr uint32_t clear_mask = (0U | ... | Fields::field_mask);
+
+            /**
+             * @brief Constructs transaction from field values.
+             *
+             * @param fields Field masks with values.
+             */
+            constexpr explicit Transaction(Fields... fields) : set_mask{(0U | ... | fields.value)} {}
+
+            /**
+             * @brief Adds another field to the transaction.
+             *
+             * @param field Field mask with value.
+             * @return New transaction containing also `field`.
+             */
+            template<typename Field>
+            constexpr Transaction<Reg, Fields..., Field> with(Field field) const
+            {
+                return Transaction<Reg, Fields..., Field>{RawValueTag{}, set_mask | field.value};
+            }
+
+            /// @brief Returns combined value of all gathered fields.
+            constexpr uint32_t get_set_mask() const
+            {
+                return set_mask;
+            }
+
+            /**
+             * @brief Writes all gathered fields with one read and one write.
+             *
+             * @return `StatusCode`.
+             */
+            StatusCode commit() const
+            {
+                return Reg::modify(RawMask{clear_mask}, RawMask{set_mask});
+            }
+    };
+}
+
 /**
  * @brief Base Register class for building concrete registers.
  *
@@ -149,16 +297,37 @@ struct RegisterMask
  *
  * @tparam Tag     A type uniquely identifying the register (used to match masks).
  * @tparam Address Physical address of the hardware register.
+ * @tparam Access  Access backend, `reg::MmioAccess` on the MCU or `reg::sim::SimAccess` on host.
  */
-template<typename Tag, uint32_t Addr>
+template<typename Tag, uint32_t Addr, typename Access = reg::DefaultAccess>
 class Register
 {
     public:
         Register() = delete;
+
+        /// @brief Register tag, masks with other tags are rejected.
+        using tag_type = Tag;
     
+        /**
+         * @brief Returns bit-band alias address of the register bit.
+         *
+         * @tparam Bit Bit position within the register.
+         * @return Alias word address, computed at compile time.
+         */
+        template<uint32_t Bit>
+        static constexpr uint32_t bit_band_addr()
+        {
+            static_assert(reg::in_bit_band_region(Addr), "Register has no bit-band alias");
+            static_assert(Bit < 32, "Bit position out of register");
+            return reg::bit_band_alias(Addr, Bit);
+        }
+
         /**
          * @brief Sets bits in the register (bitwise OR with mask).
          *
+         * Single bit fields of bit-band mapped registers are set with one store to the
+         * alias word, which is atomic and needs no critical section.
+         *
          * @param mask The `RegisterMask` to set.
          * @return `StatusCode`.
          */
@@ -166,7 +335,16 @@ class Register
         static inline StatusCode set(RegisterMask<Tag, AccessFlag, Width, Position, ValueType, IsComposite> mask) 
         {
             static_assert(AccessFlag != reg::BitFieldAccessFlag::RO, "Trying to set a read-only field");
-            *reinterpret_cast<volatile uint32_t*>(Addr) |= mask.value;
+            static_assert(AccessFlag != reg::BitFieldAccessFlag::RC_W0, "rc_w0 fields can only be cleared");
+            if constexpr (Width == 1 && !IsComposite && reg::in_bit_band_region(Addr))
+            {
+                if (mask.value)
+                    Access::store(bit_band_addr<Position>(), 1U);
+            }
+            else
+            {
+                Access::store(Addr, Access::load(Addr) | mask.value);
+            }
 
             return StatusCode::Ok;
         }
@@ -174,6 +352,10 @@ class Register
         /**
          * @brief Clears bits in the register (bitwise AND with inverted mask).
          *
+         * Single bit fields of bit-band mapped registers are cleared with one store to the alias word.
+         * rc_w0 flags are cleared by writing the inverted mask: writing 1 leaves the other flags
+         * untouched, while a read-modify-write (bit-band included) could clear flags set meanwhile.
+         *
          * @param mask The `RegisterMask` to clear.
          * @return `StatusCode`.
          */
@@ -181,11 +363,78 @@ class Register
         static inline StatusCode clear(RegisterMask<Tag, AccessFlag, Width, Position, ValueType, IsComposite> mask) 
         {
             static_assert(AccessFlag != reg::BitFieldAccessFlag::RO, "Trying to clear a read-only field");
-            *reinterpret_cast<volatile uint32_t*>(Addr) &= ~mask.value;
+            if constexpr (AccessFlag == reg::BitFieldAccessFlag::RC_W0)
+            {
+                Access::store(Addr, ~mask.value);
+            }
+            else if constexpr (Width == 1 && !IsComposite && reg::in_bit_band_region(Addr))
+            {
+                if (mask.value)
+                    Access::store(bit_band_addr<Position>(), 0U);
+            }
+            else
+            {
+                Access::store(Addr, Access::load(Addr) & ~mask.value);
+            }
 
             return StatusCode::Ok;
         }
     
+        /**
+         * @brief Clears and sets bits in a single read-modify-write access.
+         *
+         * Register is read once, `clear_mask` bits are cleared, `set_mask` bits are set
+         * and the result is written back once. Use it instead of `clear()` followed by `set()`,
+         * so the register never holds a half-configured value.
+         *
+         * @param clear_mask The `RegisterMask` with bits to clear.
+         * @param set_mask   The `RegisterMask` with bits to set.
+         * @return `StatusCode`.
+         */
+        template<typename ClearTag, reg::BitFieldAccessFlag ClearAccessFlag, uint32_t ClearWidth, uint32_t ClearPosition, typename ClearValueType, bool ClearIsComposite,
+                 typename SetTag, reg::BitFieldAccessFlag SetAccessFlag, uint32_t SetWidth, uint32_t SetPosition, typename SetValueType, bool SetIsComposite>
+        static inline StatusCode modify(RegisterMask<ClearTag, ClearAccessFlag, ClearWidth, ClearPosition, ClearValueType, ClearIsComposite> clear_mask,
+                                        RegisterMask<SetTag, SetAccessFlag, SetWidth, SetPosition, SetValueType, SetIsComposite> set_mask)
+        {
+            static_assert(std::is_same_v<ClearTag, Tag> && std::is_same_v<SetTag, Tag>, "Mismatched tags");
+            static_assert(ClearAccessFlag != reg::BitFieldAccessFlag::RO && SetAccessFlag != reg::BitFieldAccessFlag::RO, "Trying to modify a read-only field");
+            static_assert(ClearAccessFlag != reg::BitFieldAccessFlag::RC_W0 && SetAccessFlag != reg::BitFieldAccessFlag::RC_W0, "rc_w0 fields are cleared with clear()");
+            Access::store(Addr, (Access::load(Addr) & ~clear_mask.value) | set_mask.value);
+
+            return StatusCode::Ok;
+        }
+
+        /**
+         * @brief Writes values of several fields in a single read-modify-write access.
+         *
+         * Every field is cleared over its whole width and then set to the given value,
+         * so `modify_fields(rcc::PllMMask(4), rcc::PllNMask(192))` costs one read and one write.
+         * Same constraints as `reg::Transaction` apply.
+         *
+         * @param fields The `RegisterMask` fields with values to write.
+         * @return `StatusCode`.
+         */
+        template<typename... Fields>
+        static inline StatusCode modify_fields(Fields... fields)
+        {
+            static_assert(sizeof...(Fields) > 0, "At least one field is required");
+            return batch(fields...).commit();
+        }
+
+        /**
+         * @brief Starts a transaction that gathers field writes for this register.
+         *
+         * More fields can be added with `with()`, nothing is accessed until `commit()`.
+         *
+         * @param fields The `RegisterMask` fields with values to write.
+         * @return `reg::Transaction` for this register.
+         */
+        template<typename... Fields>
+        static constexpr reg::Transaction<Register, Fields...> batch(Fields... fields)
+        {
+            return reg::Transaction<Register, Fields...>{fields...};
+        }
+
         /**
          * @brief Overwrites the register with the given mask value.
          *
@@ -196,7 +445,7 @@ class Register
         static inline StatusCode write(RegisterMask<Tag, AccessFlag, Width, Position, ValueType, IsComposite> mask) 
         {
             static_assert(AccessFlag != reg::BitFieldAccessFlag::RO, "Trying to write a read-only field");
-            *reinterpret_cast<volatile uint32_t*>(Addr) = mask.value;
+            Access::store(Addr, mask.value);
 
             return StatusCode::Ok;
         }
@@ -214,7 +463,7 @@ class Register
         static inline RegisterMask<Tag, AccessFlag, Width, Position, uint32_t, IsComposite> read(RegisterMask<Tag, AccessFlag, Width, Position, ValueType, IsComposite> mask) 
         {
             static_assert(AccessFlag != reg::BitFieldAccessFlag::WO, "Trying to read a write-only field");
-            uint32_t raw = *reinterpret_cast<volatile uint32_t*>(Addr) & mask.value;
+            uint32_t raw = Access::load(Addr) & mask.value;
             if constexpr (IsComposite)
             {
                 return RegisterMask<Tag, AccessFlag, Width, Position, uint32_t, IsComposite>{ raw };
@@ -0,0 +1,226 @@
+#ifndef _REGISTER_SIM_HPP_
+#define _REGISTER_SIM_HPP_
+
+#include "./bit_band.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Host side register simulation.
+ *
+ * Selected by defining `HAL_HOST_SIM`, then every `Register` access lands in
+ * `RegisterFile` instead of the bus. Each access is logged with its kind, address
+ * and value, so drivers can be regression tested and bus accesses per operation
+ * counted in a normal host build.
+ */
+namespace reg::sim
+{
+    /**
+     * @brief Kind of the logged register access.
+     */
+    enum class AccessKind : uint8_t
+    {
+        Read,
+        Write
+    };
+
+    /**
+     * @brief Single logged register access.
+     */
+    struct AccessRecord
+    {
+        AccessKind kind;  ///< Read or write
+        uint32_t addr;    ///< Register address
+        uint32_t value;   ///< Value read or written
+    };
+
+    /**
+     * @brief Simulated register file with an access log.
+     *
+     * Registers that were never written read as zero. Hooks can be attached to model
+     * hardware behavior, e.g. a ready flag that reads as set or a write-1-to-clear register.
+     * Accesses to the peripheral bit-band alias region are translated to the targeted bit.
+     */
+    class RegisterFile
+    {
+        public:
+            /// @brief Hook called on read, receives stored value and returns value seen by the driver.
+            using ReadHook  = std::function<uint32_t(uint32_t stored)>;
+
+            /// @brief Hook called on write, receives stored and written value and returns new stored value.
+            using WriteHook = std::function<uint32_t(uint32_t stored, uint32_t written)>;
+
+            /**
+             * @brief Returns register file used by `SimAccess`.
+             */
+            static RegisterFile& instance()
+            {
+                static RegisterFile file;
+                return file;
+            }
+
+            /**
+             * @brief Logged read of the register.
+             *
+             * @param addr Register address.
+             * @return Register value.
+             */
+            uint32_t load(uint32_t addr)
+            {
+                if (is_bit_band_alias(addr))
+                {
+                    const uint32_t value = (read_word(bit_band_target_addr(addr)) >> bit_band_target_bit(addr)) & 1U;
+                    access_log.push_back({AccessKind::Read, addr, value});
+                    return value;
+                }
+
+                const uint32_t value = read_word(addr);
+                access_log.push_back({AccessKind::Read, addr, value});
+                return value;
+            }
+
+            /**
+             * @brief Logged write of the register.
+             *
+             * Writes to the bit-band alias region are logged with the alias address
+             * and applied to the targeted register bit.
+             *
+             * @param addr  Register address.
+             * @param value Value to write.
+             */
+            void store(uint32_t addr, uint32_t value)
+            {
+                access_log.push_back({AccessKind::Write, addr, value});
+                if (is_bit_band_alias(addr))
+                {
+                    const uint32_t target = bit_band_target_addr(addr);
+                    const uint32_t bit = 1U << bit_band_target_bit(addr);
+                    const uint32_t word = read_word(target);
+                    write_word(target, (value & 1U) ? (word | bit) : (word & ~bit));
+                }
+                else
+                {
+                    write_word(addr, value);
+                }
+            }
+
+            /**
+             * @brief Reads stored value without logging and without hooks.
+             */
+            uint32_t peek(uint32_t addr) const
+            {
+                auto reg = registers.find(addr);
+                return (reg != registers.end()) ? reg->second : 0U;
+            }
+
+            /**
+             * @brief Writes stored value without logging and without hooks.
+             */
+            void poke(uint32_t addr, uint32_t value)
+            {
+                registers[addr] = value;
+            }
+
+            /// @brief Attaches read hook to the register address.
+            void on_read(uint32_t addr, ReadHook hook)
+            {
+                read_hooks[addr] = std::move(hook);
+            }
+
+            /// @brief Attaches write hook to the register address.
+            void on_write(uint32_t addr, WriteHook hook)
+            {
+                write_hooks[addr] = std::move(hook);
+            }
+
+            /// @brief Logged accesses in order of execution.
+            const std::vector<AccessRecord>& log() const
+            {
+                return access_log;
+            }
+
+            /// @brief Number of logged reads, optionally only for the given address.
+            std::size_t reads(uint32_t addr = 0) const
+            {
+                return count(AccessKind::Read, addr);
+            }
+
+            /// @brief Number of logged writes, optionally only for the given address.
+            std::size_t writes(uint32_t addr = 0) const
+            {
+                return count(AccessKind::Write, addr);
+            }
+
+            /// @brief Clears access log, keeps register values and hooks.
+            void clear_log()
+            {
+                access_log.clear();
+            }
+
+            /// @brief Clears register values, hooks and access log.
+            void reset()
+            {
+                registers.clear();
+                read_hooks.clear();
+                write_hooks.clear();
+                access_log.clear();
+            }
+
+        private:
+            uint32_t read_word(uint32_t addr)
+            {
+                uint32_t value = peek(addr);
+                if (auto hook = read_hooks.find(addr); hook != read_hooks.end())
+                    value = hook->second(value);
+
+                return value;
+            }
+
+            void write_word(uint32_t addr, uint32_t value)
+            {
+                if (auto hook = write_hooks.find(addr); hook != write_hooks.end())
+                    value = hook->second(peek(addr), value);
+
+                registers[addr] = value;
+            }
+
+            std::size_t count(AccessKind kind, uint32_t addr) const
+            {
+                std::size_t total = 0;
+                for (const auto& record : access_log)
+                {
+                    if (record.kind == kind && (addr == 0 || record.addr == addr))
+                        ++total;
+                }
+                return total;
+            }
+
+            std::unordered_map<uint32_t, uint32_t> registers;
+            std::unordered_map<uint32_t, ReadHook> read_hooks;
+            std::unordered_map<uint32_t, WriteHook> write_hooks;
+            std::vector<AccessRecord> access_log;
+    };
+
+    /**
+     * @brief Register access backend that routes accesses to `RegisterFile::instance()`.
+     */
+    struct SimAccess
+    {
+        static inline uint32_t load(uint32_t addr)
+        {
+            return RegisterFile::instance().load(addr);
+        }
+
+        static inline void store(uint32_t addr, uint32_t value)
+        {
+            RegisterFile::instance().store(addr, value);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef _SPICRC_HPP_
+#define _SPICRC_HPP_
+
+#include "spi_regs.hpp"
+
+#include <cstdint>
+#include <stdint.h>
+
+namespace spi
+{
+    /// @brief CRC-8 polynomial x^8 + x^2 + x + 1 (CCITT), reset value of CRCPR.
+    inline constexpr uint16_t CRC8_POLYNOMIAL = 0x0007U;
+
+    /// @brief CRC-16 polynomial x^16 + x^12 + x^5 + 1 (CCITT), used by SD card data blocks.
+    inline constexpr uint16_t CRC16_POLYNOMIAL = 0x1021U;
+};
+
+/**
+ * @brief SPI hardware CRC control.
+ *
+ * Static class.
+ *
+ * CRC length follows the frame format, 8-bit frames compute CRC-8 and 16-bit frames CRC-16.
+ * With CRC enabled, `SpiPolled::transfer_crc()` and `SpiDma` transfers append the TX CRC after
+ * the payload and compare the received CRC frame, a mismatch is reported as `StatusCode::Error`.
+ * Both ends must use the same polynomial and the receiver must not count the CRC frame as payload.
+ *
+ * @tparam Periph SPI peripheral.
+ */
+template<spi::Peripherals Periph>
+class SpiCrc
+{
+    private:
+        using Regs = SpiRegs<Periph>;
+
+    public:
+        SpiCrc() = delete;
+
+        /**
+         * @brief Enables CRC calculation with the given polynomial, resets both CRC values.
+         *
+         * SPE is cleared while CRCEN changes, as required by the reference manual, and restored after.
+         * Call it only while the bus is idle.
+         *
+         * @param polynomial CRC polynomial, bit 0 (x^0) must be set.
+         * @return `StatusCode::Error` for an even polynomial.
+         */
+        static StatusCode enable(uint16_t polynomial)
+        {
+            if ((polynomial & 1U) == 0)
+                return StatusCode::Error;
+
+            const bool spi_enabled = Regs::ControlReg1::read(spi::SpiEnableMask()).value;
+            // Clearing CRCEN resets RXCRCR and TXCRCR
+            Regs::ControlReg1::modify(spi::SpiEnableMask(true) | spi::CrcEnableMask(true), spi::SpiEnableMask(false));
+            Regs::CrcPolyReg::write(spi::CrcPolynomialMask(polynomial));
+            Regs::ControlReg1::set(spi::CrcEnableMask(true));
+            if (spi_enabled)
+                Regs::ControlReg1::set(spi::SpiEnableMask(true));
+
+            return StatusCode::Ok;
+        }
+
+        /// @brief Disables CRC calculation, call it only while the bus is idle.
+        static StatusCode disable()
+        {
+            const bool spi_enabled = Regs::ControlReg1::read(spi::SpiEnableMask()).value;
+            Regs::ControlReg1::modify(spi::SpiEnableMask(true) | spi::CrcEnableMask(true), spi::SpiEnableMask(false));
+            if (spi_enabled)
+                Regs::ControlReg1::set(spi::SpiEnableMask(true));
+
+            return StatusCode::Ok;
+        }
+
+        /// @brief Clears RX and TX CRC values before the next CRC protected transfer, keeps the polynomial.
+        static StatusCode reset()
+        {
+            return enable(Regs::CrcPolyReg::read(spi::CrcPolynomialMask()).value);
+        }
+
+        /// @brief Returns true if CRC calculation is enabled.
+        static bool is_enabled()
+        {
+            return Regs::ControlReg1::read(spi::CrcEnableMask()).value;
+        }
+
+        /**
+         * @brief Checks and clears CRC error flag.
+         *
+         * @return `StatusCode::Error` if the received CRC did not match.
+         */
+        static StatusCode check()
+        {
+            if (!Regs::StatusReg::read(spi::CrcErrStatMask()).value)
+                return StatusCode::Ok;
+
+            Regs::StatusReg::clear(spi::CrcErrStatMask(true));
+            return StatusCode::Error;
+        }
+
+        /// @brief Returns CRC computed over received frames.
+        static uint16_t rx_crc()
+        {
+            return static_cast<uint16_t>(Regs::RxCrcReg::read(spi::RxCrcMask()).value);
+        }
+
+        /// @brief Returns CRC computed over transmitted frames.
+        static uint16_t tx_crc()
+        {
+            return static_cast<uint16_t>(Regs::TxCrcReg::read(spi::TxCrcMask()).value);
+        }
+};
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef _SPIDMA_HPP_
+#define _SPIDMA_HPP_
+
+#include "spi_regs.hpp"
+#include "spi_crc.hpp"
+#include "dma_stream.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+#include <type_traits>
+
+namespace spi
+{
+    /**
+     * @brief DMA requests and default streams of each SPI instance.
+     *
+     * Defaults are the first stream serving the request, other streams from
+     * the request mapping can be selected through `SpiDma` template parameters.
+     */
+    template<Peripherals Periph>
+    struct DmaRoute;
+
+    template<>
+    struct DmaRoute<Peripherals::Spi_1>
+    {
+        static constexpr dma::Request rx = dma::Request::Spi1Rx;
+        static constexpr dma::Request tx = dma::Request::Spi1Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_0;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_3;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Spi_2>
+    {
+        static constexpr dma::Request rx = dma::Request::Spi2Rx;
+        static constexpr dma::Request tx = dma::Request::Spi2Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_3;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_4;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Spi_3>
+    {
+        static constexpr dma::Request rx = dma::Request::Spi3Rx;
+        static constexpr dma::Request tx = dma::Request::Spi3Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_0;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_5;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Spi_4>
+    {
+        static constexpr dma::Request rx = dma::Request::Spi4Rx;
+        static constexpr dma::Request tx = dma::Request::Spi4Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_0;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_1;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Spi_5>
+    {
+        static constexpr dma::Request rx = dma::Request::Spi5Rx;
+        static constexpr dma::Request tx = dma::Request::Spi5Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_3;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_4;
+    };
+
+    /// @brief Transfer completion callback, receives `StatusCode::Error` on DMA error.
+    using Callback = void (*)(StatusCode status);
+};
+
+/**
+ * @brief Full-duplex SPI transfer engine on DMA.
+ *
+ * Static class.
+ *
+ * Both streams run for every transfer. Missing TX data is replaced by a dummy word read
+ * with fixed address and missing RX data is discarded into a dummy word, so completion
+ * is always signalled by RX transfer complete, after the last frame was clocked in.
+ * The SPI has to be configured and enabled beforehand, 8-bit frames are transferred from
+ * `uint8_t` buffers and 16-bit frames from `uint16_t` buffers.
+ *
+ * `rx_irq_handler()` has to be called from the RX stream interrupt handler.
+ *
+ * If CRC was enabled by `SpiCrc::enable()`, CRC values are reset before each transfer, hardware
+ * sends the TX CRC after the last DMA frame and the received CRC frame, which DMA does not
+ * transfer, is drained and checked on completion. A mismatch completes with `StatusCode::Error`.
+ *
+ * @tparam Periph   SPI peripheral.
+ * @tparam RxStream DMA stream serving SPI RX request.
+ * @tparam TxStream DMA stream serving SPI TX request.
+ */
+template<spi::Peripherals Periph,
+         dma::Streams RxStream = spi::DmaRoute<Periph>::rx_stream,
+         dma::Streams TxStream = spi::DmaRoute<Periph>::tx_stream>
+class SpiDma
+{
+    private:
+        using Regs = SpiRegs<Periph>;
+        using Rx   = DmaRequestStream<spi::DmaRoute<Periph>::rx, RxStream>;
+        using Tx   = DmaRequestStream<spi::DmaRoute<Periph>::tx, TxStream>;
+
+        inline static volatile bool busy{};
+        inline static bool crc{};
+        inline static spi::Callback callback{};
+        inline static uint16_t dummy_tx{0xFFFFU};
+        inline static uint16_t dummy_rx{};
+
+        static StatusCode start(uint32_t tx, uint32_t rx, uint16_t count, dma::DataSize size, spi::Callback on_complete)
+        {
+            // NDTR == 0 never completes, and DMA items have to match the frame size set by CR1.DFF
+            const bool frame_16bit = Regs::ControlReg1::read(spi::DataFrameFormatMask()).value;
+            if (busy || count == 0 || frame_16bit != (size == dma::DataSize::HalfWord))
+                return StatusCode::Error;
+
+            busy = true;
+            callback = on_complete;
+            crc = SpiCrc<Periph>::is_enabled();
+            if (crc)
+                SpiCrc<Periph>::reset();
+
+            const uint32_t data_addr = Regs::DataReg::get_addr();
+            const dma::StreamConfig rx_config{
+                .direction = dma::TransferDirection::PeriphToMem,
+                .periph_size = size,
+                .mem_size = size,
+                .mem_incr = (rx != 0) ? dma::AddrIncrementMode::AddrPtrIncr : dma::AddrIncrementMode::AddrPtrFixed,
+                .priority = dma::PriorityLevel::VeryHigh,
+                .tx_complete_irq = true,
+                .tx_error_irq = true
+            };
+            const dma::StreamConfig tx_config{
+                .direction = dma::TransferDirection::MemToPeriph,
+                .periph_size = size,
+                .mem_size = size,
+                .mem_incr = (tx != 0) ? dma::AddrIncrementMode::AddrPtrIncr : dma::AddrIncrementMode::AddrPtrFixed,
+                .priority = dma::PriorityLevel::High
+            };
+
+            // Order from reference manual: RX request, streams, then TX request starts the clock
+            Regs::ControlReg2::set(spi::RxBuffDmaEnMask(true));
+            Rx::start(rx_config, data_addr, (rx != 0) ? rx : address_of(&dummy_rx), count);
+            Tx::start(tx_config, (tx != 0) ? tx : address_of(&dummy_tx), data_addr, count);
+
+            return Regs::ControlReg2::set(spi::TxBuffDmaEnMask(true));
+        }
+
+        static uint32_t address_of(const volatile void* ptr)
+        {
+            return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr));
+        }
+
+        static void finish(StatusCode status)
+        {
+            Tx::abort();
+            Rx::abort();
+            Regs::ControlReg2::clear(spi::TxBuffDmaEnMask(true));
+            Regs::ControlReg2::clear(spi::RxBuffDmaEnMask(true));
+            Tx::clear_flags();
+            Rx::clear_flags();
+
+            if (crc && status == StatusCode::Ok)
+            {
+                // Received CRC frame follows the last data frame by one frame time
+                while (!Regs::StatusReg::read(spi::RxNotEmptyStatMask()).value);
+                Regs::DataReg::read(spi::DataMask());
+                status = SpiCrc<Periph>::check();
+            }
+
+            busy = false;
+            if (callback)
+                callback(status);
+        }
+
+    public:
+        SpiDma() = delete;
+
+        /**
+         * @brief Starts a full-duplex transfer.
+         *
+         * @tparam T    `uint8_t` for 8-bit frames, `uint16_t` for 16-bit frames.
+         * @param tx    Data to send, `nullptr` sends dummy frames (receive only).
+         * @param rx    Buffer for received data, `nullptr` discards received frames.
+         * @param len   Number of frames.
+         * @param on_complete Called from interrupt context when the transfer finished.
+         * @return `StatusCode::Error` if a transfer is already running, `len` is 0 or `T` does not match CR1.DFF.
+         */
+        template<typename T>
+        static StatusCode transfer(const T* tx, T* rx, uint16_t len, spi::Callback on_complete = nullptr)
+        {
+            static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>, "SPI frames are 8 or 16 bit");
+            constexpr dma::DataSize size = std::is_same_v<T, uint8_t> ? dma::DataSize::Byte : dma::DataSize::HalfWord;
+            return start(address_of(tx), address_of(rx), len, size, on_complete);
+        }
+
+        /// @brief Starts a transmit-only transfer, received frames are discarded.
+        template<typename T>
+        static StatusCode write(const T* tx, uint16_t len, spi::Callback on_complete = nullptr)
+        {
+            return transfer<T>(tx, nullptr, len, on_complete);
+        }
+
+        /// @brief Starts a receive-only transfer, dummy frames are sent.
+        template<typename T>
+        static StatusCode read(T* rx, uint16_t len, spi::Callback on_complete = nullptr)
+        {
+            return transfer<T>(nullptr, rx, len, on_complete);
+        }
+
+        /// @brief Returns true while a transfer is running.
+        static bool is_busy()
+        {
+            return busy;
+        }
+
+        /**
+         * @brief Completes the transfer, call it from the RX stream interrupt handler.
+         */
+        static void rx_irq_handler()
+        {
+            // FIFO error flag is not relevant in direct mode
+            if (Rx::has_tx_error())
+                finish(StatusCode::Error);
+            else if (Rx::is_complete())
+                finish(StatusCode::Ok);
+        }
+};
+
+#endif
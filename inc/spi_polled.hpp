@@ -0,0 +1,162 @@
+#ifndef _SPIPOLLED_HPP_
+#define _SPIPOLLED_HPP_
+
+#include "spi_regs.hpp"
+#include "spi_crc.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Blocking SPI burst transfers for short messages, where DMA setup costs more than it saves.
+ *
+ * Static class.
+ *
+ * TX and RX are pipelined: a new frame is written as soon as TXE is set while the previous one
+ * is still shifting out, received frames are drained on RXNE in the same loop. At most two frames
+ * are in flight (shift register and DR), so the RX side can never overrun as long as the loop is
+ * faster than one frame time. Status register is read once per iteration, overrun and mode fault
+ * are checked only after the burst, or when RXNE stays clear for `MAX_STALL_POLLS` reads, which is
+ * how a lost frame or a dropped master mode shows up. The SPI has to be configured as master and enabled beforehand,
+ * 8-bit frames are transferred from `uint8_t` buffers and 16-bit frames from `uint16_t` buffers.
+ *
+ * Throughput can be measured on target with `CycleCounter::measure()` from `core_regs.hpp`.
+ *
+ * @tparam Periph SPI peripheral.
+ */
+template<spi::Peripherals Periph>
+class SpiPolled
+{
+    public:
+        /// @brief Status reads without a received frame before the burst is aborted, well above one frame at `Div_256`.
+        static constexpr uint32_t MAX_STALL_POLLS = 100000;
+
+    private:
+        using Regs = SpiRegs<Periph>;
+
+        static constexpr uint32_t TXE  = spi::TxNotEmptyStatMask(true);
+        static constexpr uint32_t RXNE = spi::RxNotEmptyStatMask(true);
+
+        template<typename T, bool Crc>
+        static StatusCode burst(const T* tx, T* rx, size_t len)
+        {
+            static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>, "SPI frames are 8 or 16 bit");
+
+            // With CRC one more frame is received, the CRC sent by the other end
+            const size_t frames = Crc ? len + 1 : len;
+            size_t sent = 0;
+            size_t received = 0;
+            uint32_t stalled = 0;
+            while (received < frames)
+            {
+                const uint32_t status = Regs::StatusReg::read(spi::TxNotEmptyStatMask(true) | spi::RxNotEmptyStatMask(true));
+                if (status & RXNE)
+                {
+                    const T value = static_cast<T>(Regs::DataReg::read(spi::DataMask()).value);
+                    if (rx && received < len)
+                        rx[received] = value;
+                    ++received;
+                    stalled = 0;
+                }
+                else if (++stalled == MAX_STALL_POLLS)
+                {
+                    // Frame lost to an overrun or mode fault, the count can not be reached anymore
+                    (void) finish();
+                    if constexpr (Crc)
+                        Regs::ControlReg1::clear(spi::CrcNextMask(spi::CrcNext::NextTransferIsCRC));
+                    return StatusCode::Error;
+                }
+
+                if ((status & TXE) && sent < len && (sent - received) < 2)
+                {
+                    Regs::DataReg::write(spi::DataMask(tx ? tx[sent] : static_cast<T>(~T{})));
+                    ++sent;
+                    // CRCNEXT right after the last data frame was written, TX CRC follows it
+                    if (Crc && sent == len)
+                        Regs::ControlReg1::set(spi::CrcNextMask(spi::CrcNext::NextTransferIsCRC));
+                }
+            }
+
+            const StatusCode status = finish();
+            if constexpr (Crc)
+            {
+                Regs::ControlReg1::clear(spi::CrcNextMask(spi::CrcNext::NextTransferIsCRC));
+                if (SpiCrc<Periph>::check() != StatusCode::Ok)
+                    return StatusCode::Error;
+            }
+
+            return status;
+        }
+
+        static StatusCode finish()
+        {
+            uint32_t polls = 0;
+            while (Regs::StatusReg::read(spi::BusyStatMask()).value && ++polls < MAX_STALL_POLLS);
+
+            const uint32_t errors = Regs::StatusReg::read(spi::OverrunStatMask(true) | spi::ModeFaultStatMask(true));
+            if (errors == 0)
+                return (polls < MAX_STALL_POLLS) ? StatusCode::Ok : StatusCode::Error;
+
+            // OVR is cleared by DR read followed by SR read, MODF by the SR read above and a CR1 write
+            Regs::DataReg::read(spi::DataMask());
+            Regs::StatusReg::read(spi::OverrunStatMask());
+            if (errors & spi::ModeFaultStatMask(true))
+                Regs::ControlReg1::set(spi::MasterSelectMask(spi::MasterSelection::Master) | spi::SpiEnableMask(true));
+
+            return StatusCode::Error;
+        }
+
+    public:
+        SpiPolled() = delete;
+
+        /**
+         * @brief Runs a full-duplex burst and waits until the bus is idle.
+         *
+         * @tparam T  `uint8_t` for 8-bit frames, `uint16_t` for 16-bit frames.
+         * @param tx  Data to send, `nullptr` sends 0xFF/0xFFFF frames.
+         * @param rx  Buffer for received data, `nullptr` discards received frames.
+         * @param len Number of frames.
+         * @return `StatusCode::Error` on overrun, mode fault or when the bus stalls.
+         */
+        template<typename T>
+        static StatusCode transfer(const T* tx, T* rx, size_t len)
+        {
+            return burst<T, false>(tx, rx, len);
+        }
+
+        /**
+         * @brief Runs a CRC protected full-duplex burst, CRC has to be enabled by `SpiCrc::enable()`.
+         *
+         * CRC values are reset first, the TX CRC frame is sent after the payload and the received
+         * CRC frame is compared by hardware and not stored in `rx`.
+         *
+         * @return `StatusCode::Error` on overrun, mode fault or CRC mismatch.
+         */
+        template<typename T>
+        static StatusCode transfer_crc(const T* tx, T* rx, size_t len)
+        {
+            if (len == 0)
+                return StatusCode::Ok;
+
+            SpiCrc<Periph>::reset();
+            return burst<T, true>(tx, rx, len);
+        }
+
+        /// @brief Transmit-only burst, received frames are discarded.
+        template<typename T>
+        static StatusCode write(const T* tx, size_t len)
+        {
+            return transfer<T>(tx, nullptr, len);
+        }
+
+        /// @brief Receive-only burst, 0xFF/0xFFFF frames are sent.
+        template<typename T>
+        static StatusCode read(T* rx, size_t len)
+        {
+            return transfer<T>(nullptr, rx, len);
+        }
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef _SPIQUEUE_HPP_
+#define _SPIQUEUE_HPP_
+
+#include "spi_dma.hpp"
+#include "gpio_regs.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+
+namespace spi
+{
+    /**
+     * @brief Device on a shared SPI bus: chip select and CR1 settings.
+     *
+     * Use `make_device()` to build it at compile time.
+     */
+    struct Device
+    {
+        uint32_t control;            ///< Complete CR1 value for the device, including SPE
+        StatusCode (*select)();      ///< Drives chip select active (low)
+        StatusCode (*deselect)();    ///< Drives chip select inactive (high)
+    };
+
+    /**
+     * @brief Builds a master mode device descriptor with software managed chip select.
+     *
+     * Chip select is driven through BSRR, the pin has to be configured as output beforehand.
+     *
+     * @tparam CsPort  Chip select port.
+     * @tparam CsPin   Chip select pin (active low).
+     * @tparam Cpol    Clock polarity.
+     * @tparam Cpha    Clock phase.
+     * @tparam Baud    Baud rate divider.
+     * @tparam Format  Data frame format.
+     */
+    template<gpio::Port CsPort, gpio::Pins CsPin, ClockPolarity Cpol, ClockPhase Cpha, BaudRateControl Baud, DataFrameFormat Format = DataFrameFormat::_8bit>
+    constexpr Device make_device()
+    {
+        return Device{
+            ClkPolarityMask(Cpol) | ClkPhaseMask(Cpha) | BaudRateCtrlMask(Baud) | DataFrameFormatMask(Format)
+            | MasterSelectMask(MasterSelection::Master) | SlaveMngMask(SlaveMng::Software)
+            | InternSlaveSelMask(InternSlaveSelect::Deselect) | SpiEnableMask(true),
+            &gpio::PinSet<CsPin>::template reset<CsPort>,
+            &gpio::PinSet<CsPin>::template set<CsPort>
+        };
+    }
+
+    /**
+     * @brief Single queued transaction, frames are 16-bit if the device uses 16-bit format.
+     */
+    struct Transaction
+    {
+        const Device* device;
+        const void* tx;              ///< Data to send, `nullptr` sends dummy frames
+        void* rx;                    ///< Buffer for received data, `nullptr` discards them
+        uint16_t len;                ///< Number of frames
+        Callback on_complete;        ///< Called from interrupt context after chip select was released
+    };
+};
+
+/**
+ * @brief Allocation-free SPI transaction queue for several devices on one bus.
+ *
+ * Static class.
+ *
+ * Transactions are started back to back from the DMA completion interrupt: chip select is
+ * released, the next device selected and CR1 rewritten only when its settings differ from
+ * the previous transaction. `SpiDma::rx_irq_handler()` has to be called from the RX stream
+ * interrupt handler.
+ *
+ * `submit()` is meant for a single producer (thread context), the interrupt only consumes.
+ *
+ * @tparam Periph   SPI peripheral.
+ * @tparam Capacity Queue size, power of two.
+ * @tparam RxStream DMA stream serving SPI RX request.
+ * @tparam TxStream DMA stream serving SPI TX request.
+ */
+template<spi::Peripherals Periph, size_t Capacity = 8,
+         dma::Streams RxStream = spi::DmaRoute<Periph>::rx_stream,
+         dma::Streams TxStream = spi::DmaRoute<Periph>::tx_stream>
+class SpiQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+    private:
+        using Regs = SpiRegs<Periph>;
+        using Bus  = SpiDma<Periph, RxStream, TxStream>;
+
+        inline static spi::Transaction slots[Capacity]{};
+        inline static std::atomic<uint32_t> head{0};
+        inline static std::atomic<uint32_t> tail{0};
+        inline static std::atomic<bool> active{false};
+        inline static uint32_t control_shadow{0};
+
+        static void start_head()
+        {
+            const spi::Transaction& next = slots[head.load(std::memory_order_relaxed) & (Capacity - 1)];
+            if (next.device->control != control_shadow)
+            {
+                control_shadow = next.device->control;
+                // Settings must not change while SPE is set, the peripheral is enabled by a second store
+                Regs::ControlReg1::write(RegisterMask<spi::CR1_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{control_shadow & ~spi::SpiEnableMask(true).value});
+                if (control_shadow & spi::SpiEnableMask(true))
+                    Regs::ControlReg1::set(spi::SpiEnableMask(true));
+            }
+
+            next.device->select();
+            StatusCode status;
+            if (next.device->control & spi::DataFrameFormatMask(spi::DataFrameFormat::_16bit))
+                status = Bus::transfer(static_cast<const uint16_t*>(next.tx), static_cast<uint16_t*>(next.rx), next.len, &on_transfer_complete);
+            else
+                status = Bus::transfer(static_cast<const uint8_t*>(next.tx), static_cast<uint8_t*>(next.rx), next.len, &on_transfer_complete);
+
+            // Completion never comes for a transfer that did not start, the job ends here
+            if (status != StatusCode::Ok)
+                on_transfer_complete(StatusCode::Error);
+        }
+
+        static void kick()
+        {
+            bool idle = false;
+            if (head.load(std::memory_order_acquire) != tail.load(std::memory_order_acquire) &&
+                active.compare_exchange_strong(idle, true, std::memory_order_acq_rel))
+            {
+                start_head();
+            }
+        }
+
+        static void on_transfer_complete(StatusCode status)
+        {
+            const spi::Transaction done = slots[head.load(std::memory_order_relaxed) & (Capacity - 1)];
+            done.device->deselect();
+            head.fetch_add(1, std::memory_order_release);
+            active.store(false, std::memory_order_release);
+
+            if (done.on_complete)
+                done.on_complete(status);
+
+            kick();
+        }
+
+    public:
+        SpiQueue() = delete;
+
+        /**
+         * @brief Queues a transaction, starts it right away if the bus is idle.
+         *
+         * Buffers and the device descriptor must stay valid until the transaction completed.
+         * A transaction that fails to start completes with `StatusCode::Error` and the next one is started.
+         *
+         * @param transaction Transaction to queue.
+         * @return `StatusCode::Error` if the queue is full, the transaction has no device or no frames.
+         */
+        static StatusCode submit(const spi::Transaction& transaction)
+        {
+            if (transaction.device == nullptr || transaction.len == 0)
+                return StatusCode::Error;
+
+            const uint32_t write = tail.load(std::memory_order_relaxed);
+            if (write - head.load(std::memory_order_acquire) >= Capacity)
+                return StatusCode::Error;
+
+            slots[write & (Capacity - 1)] = transaction;
+            tail.store(write + 1, std::memory_order_release);
+            kick();
+
+            return StatusCode::Ok;
+        }
+
+        /// @brief Returns number of queued transactions, including the running one.
+        static size_t pending()
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        /// @brief Returns true while a transaction is running.
+        static bool is_busy()
+        {
+            return active.load(std::memory_order_acquire);
+        }
+};
+
+#endif
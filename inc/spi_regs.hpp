@@ -106,6 +106,9 @@ namespace spi
     struct CR2_Tag {};
     struct SR_Tag {};
     struct DR_Tag {};
+    struct CRCPR_Tag {};
+    struct RXCRCR_Tag {};
+    struct TXCRCR_Tag {};
 
     using ClkPhaseMask        = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 0, ClockPhase>;
     using ClkPolarityMask     = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 1, ClockPolarity>;
@@ -134,13 +137,17 @@ namespace spi
     using TxNotEmptyStatMask     = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 1, bool>;
     using ChSideStatMask         = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 2, bool>;
     using UnderrrunStatMask      = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 3, bool>;
-    using CrcErrStatMask         = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 4, bool>;
+    using CrcErrStatMask         = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RC_W0, 1, 4, bool>;
     using ModeFaultStatMask      = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 5, bool>;
     using OverrunStatMask        = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 6, bool>;
     using BusyStatMask           = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 7, bool>;
     using FrameFormatErrStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 8, bool>;
 
     using DataMask               = RegisterMask<DR_Tag,  reg::BitFieldAccessFlag::RW, 16, 0,  uint16_t>;
+
+    using CrcPolynomialMask      = RegisterMask<CRCPR_Tag,  reg::BitFieldAccessFlag::RW, 16, 0, uint16_t>;
+    using RxCrcMask              = RegisterMask<RXCRCR_Tag, reg::BitFieldAccessFlag::RO, 16, 0, uint16_t>;
+    using TxCrcMask              = RegisterMask<TXCRCR_Tag, reg::BitFieldAccessFlag::RO, 16, 0, uint16_t>;
 };
 
 /**
@@ -163,6 +170,16 @@ class SpiRegs
         using ControlReg2 = Register<spi::CR2_Tag, BASE_ADDR + 0x04>;
         using StatusReg   = Register<spi::SR_Tag,  BASE_ADDR + 0x08>;
         using DataReg     = Register<spi::DR_Tag,  BASE_ADDR + 0x0C>;
+        using CrcPolyReg  = Register<spi::CRCPR_Tag,  BASE_ADDR + 0x10>;
+        using RxCrcReg    = Register<spi::RXCRCR_Tag, BASE_ADDR + 0x14>;
+        using TxCrcReg    = Register<spi::TXCRCR_Tag, BASE_ADDR + 0x18>;
 };
 
+// Bit-band alias of every SPI base, values as computed by the reference manual formula
+static_assert(SpiRegs<spi::Peripherals::Spi_1>::ControlReg1::bit_band_addr<0>() == 0x42260000UL, "SPI1 bit-band alias mismatch");
+static_assert(SpiRegs<spi::Peripherals::Spi_2>::ControlReg1::bit_band_addr<0>() == 0x42070000UL, "SPI2 bit-band alias mismatch");
+static_assert(SpiRegs<spi::Peripherals::Spi_3>::ControlReg1::bit_band_addr<0>() == 0x42078000UL, "SPI3 bit-band alias mismatch");
+static_assert(SpiRegs<spi::Peripherals::Spi_4>::ControlReg1::bit_band_addr<0>() == 0x42268000UL, "SPI4 bit-band alias mismatch");
+static_assert(SpiRegs<spi::Peripherals::Spi_5>::ControlReg1::bit_band_addr<0>() == 0x422A0000UL, "SPI5 bit-band alias mismatch");
+
 #endif
@@ -0,0 +1,117 @@
+#ifndef _SPSCRING_HPP_
+#define _SPSCRING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer.
+ *
+ * One context only pushes and one context only pops, e.g. thread and interrupt, no critical
+ * sections are needed. Indices run freely and wrap through the power-of-two size, so all slots
+ * are usable. The producer publishes data with a release store of `tail` after writing the slots
+ * and the consumer frees slots with a release store of `head` after reading them.
+ *
+ * @tparam T    Element type, trivially copyable.
+ * @tparam Size Number of elements, power of two.
+ */
+template<typename T, size_t Size>
+class SpscRing
+{
+    static_assert(Size > 1 && (Size & (Size - 1)) == 0, "Ring size must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "Ring elements are copied by value");
+
+    private:
+        static constexpr uint32_t MASK = Size - 1;
+
+        T buffer[Size]{};
+        std::atomic<uint32_t> head{0}; ///< Next element to pop, written by the consumer only
+        std::atomic<uint32_t> tail{0}; ///< Next free slot, written by the producer only
+
+    public:
+        /// @brief Producer side: appends the element, returns false if the ring is full.
+        bool push(const T& value)
+        {
+            const uint32_t at = tail.load(std::memory_order_relaxed);
+            if (at - head.load(std::memory_order_acquire) == Size)
+                return false;
+
+            buffer[at & MASK] = value;
+            tail.store(at + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Producer side: appends as many elements as fit, published with a single store.
+         *
+         * @return Number of elements appended.
+         */
+        size_t push(const T* data, size_t len)
+        {
+            const uint32_t at = tail.load(std::memory_order_relaxed);
+            const uint32_t space = Size - (at - head.load(std::memory_order_acquire));
+            const uint32_t count = (len < space) ? static_cast<uint32_t>(len) : space;
+
+            for (uint32_t i = 0; i < count; ++i)
+                buffer[(at + i) & MASK] = data[i];
+
+            tail.store(at + count, std::memory_order_release);
+            return count;
+        }
+
+        /// @brief Consumer side: removes the oldest element, returns false if the ring is empty.
+        bool pop(T& value)
+        {
+            const uint32_t at = head.load(std::memory_order_relaxed);
+            if (at == tail.load(std::memory_order_acquire))
+                return false;
+
+            value = buffer[at & MASK];
+            head.store(at + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer side: removes up to `len` oldest elements, freed with a single store.
+         *
+         * @return Number of elements removed.
+         */
+        size_t pop(T* out, size_t len)
+        {
+            const uint32_t at = head.load(std::memory_order_relaxed);
+            const uint32_t used = tail.load(std::memory_order_acquire) - at;
+            const uint32_t count = (len < used) ? static_cast<uint32_t>(len) : used;
+
+            for (uint32_t i = 0; i < count; ++i)
+                out[i] = buffer[(at + i) & MASK];
+
+            head.store(at + count, std::memory_order_release);
+            return count;
+        }
+
+        /// @brief Returns number of stored elements, exact only from the producer or consumer side.
+        size_t size() const
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        bool full() const
+        {
+            return size() == Size;
+        }
+
+        static constexpr size_t capacity()
+        {
+            return Size;
+        }
+};
+
+#endif
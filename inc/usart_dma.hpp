@@ -0,0 +1,408 @@
+#ifndef _USARTDMA_HPP_
+#define _USARTDMA_HPP_
+
+#include "usart_regs.hpp"
+#include "dma_stream.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+
+namespace usart
+{
+    /**
+     * @brief DMA requests and default streams of each USART instance.
+     *
+     * Defaults are the first stream serving the request, other streams from
+     * the request mapping can be selected through driver template parameters.
+     */
+    template<Peripherals Periph>
+    struct DmaRoute;
+
+    template<>
+    struct DmaRoute<Peripherals::Usart1>
+    {
+        static constexpr dma::Request rx = dma::Request::Usart1Rx;
+        static constexpr dma::Request tx = dma::Request::Usart1Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_2;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_7;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Usart2>
+    {
+        static constexpr dma::Request rx = dma::Request::Usart2Rx;
+        static constexpr dma::Request tx = dma::Request::Usart2Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_5;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_6;
+    };
+
+    template<>
+    struct DmaRoute<Peripherals::Usart6>
+    {
+        static constexpr dma::Request rx = dma::Request::Usart6Rx;
+        static constexpr dma::Request tx = dma::Request::Usart6Tx;
+        static constexpr dma::Streams rx_stream = dma::Streams::Stream_1;
+        static constexpr dma::Streams tx_stream = dma::Streams::Stream_6;
+    };
+
+    /**
+     * @brief Contiguous part of a buffer.
+     */
+    struct Span
+    {
+        const uint8_t* data;
+        size_t len;
+    };
+
+    /**
+     * @brief Event that published received data.
+     */
+    enum class RxEvent : uint8_t
+    {
+        IdleLine,     ///< Line went idle, end of a frame
+        HalfTransfer, ///< DMA reached middle of the ring
+        Wrap          ///< DMA reached end of the ring
+    };
+
+    /// @brief Receive callback, called from interrupt context once per contiguous span.
+    using RxCallback = void (*)(Span data, RxEvent event);
+
+    /// @brief Transmit callback, called from interrupt context once DMA no longer reads the buffer.
+    using TxCallback = void (*)(const uint8_t* data, StatusCode status);
+};
+
+/**
+ * @brief Always-on USART receiver on a circular DMA stream.
+ *
+ * Static class.
+ *
+ * DMA writes into a caller-provided ring without any per-byte interrupt. Data written since the
+ * last event are published on line idle, half transfer and transfer complete, directly as spans
+ * of the ring, so variable-length frames are delivered as soon as the line goes quiet. Data that
+ * wrap the end of the ring are published as two spans. The callback has to consume the span before
+ * DMA wraps around to it again, i.e. within half of the ring time.
+ *
+ * `irq_handler()` has to be called from the USART interrupt handler and `dma_irq_handler()`
+ * from the RX stream interrupt handler, both interrupts must have the same priority.
+ * The USART has to be configured beforehand.
+ *
+ * @tparam Periph   USART peripheral.
+ * @tparam RxStream DMA stream serving USART RX request.
+ */
+template<usart::Peripherals Periph, dma::Streams RxStream = usart::DmaRoute<Periph>::rx_stream>
+class UsartDmaRx
+{
+    private:
+        using Regs = UsartRegs<Periph>;
+        using Rx   = DmaRequestStream<usart::DmaRoute<Periph>::rx, RxStream>;
+
+        inline static uint8_t* ring{};
+        inline static uint16_t ring_size{};
+        inline static uint16_t read_pos{};
+        inline static usart::RxCallback callback{};
+
+        static void publish(usart::RxEvent event)
+        {
+            const uint16_t write_pos = static_cast<uint16_t>(ring_size - Rx::remaining());
+            if (write_pos == read_pos)
+                return;
+
+            if (write_pos > read_pos)
+            {
+                callback({ring + read_pos, static_cast<size_t>(write_pos - read_pos)}, event);
+            }
+            else
+            {
+                callback({ring + read_pos, static_cast<size_t>(ring_size - read_pos)}, event);
+                if (write_pos != 0)
+                    callback({ring, write_pos}, event);
+            }
+
+            read_pos = (write_pos == ring_size) ? 0 : write_pos;
+        }
+
+    public:
+        UsartDmaRx() = delete;
+
+        /**
+         * @brief Starts reception into the ring.
+         *
+         * @param buffer      Ring buffer, must stay valid until `stop()`.
+         * @param size        Ring size in bytes, at least 2.
+         * @param on_receive  Called from interrupt context with received spans.
+         * @return `StatusCode::Error` for invalid arguments.
+         */
+        static StatusCode start(uint8_t* buffer, uint16_t size, usart::RxCallback on_receive)
+        {
+            if (buffer == nullptr || size < 2 || on_receive == nullptr)
+                return StatusCode::Error;
+
+            ring = buffer;
+            ring_size = size;
+            read_pos = 0;
+            callback = on_receive;
+
+            const dma::StreamConfig config{
+                .direction = dma::TransferDirection::PeriphToMem,
+                .periph_size = dma::DataSize::Byte,
+                .mem_size = dma::DataSize::Byte,
+                .mem_incr = dma::AddrIncrementMode::AddrPtrIncr,
+                .priority = dma::PriorityLevel::High,
+                .circular = true,
+                .tx_complete_irq = true,
+                .half_tx_irq = true
+            };
+
+            Rx::start(config, Regs::DataReg::get_addr(), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer)), size);
+            Regs::ControlReg3::set(usart::DmaRxEnableMask(true));
+
+            // Clear stale IDLE flag (SR read followed by DR read) before enabling its interrupt
+            Regs::StatusReg::read(usart::IdleLineDetStatMask());
+            Regs::DataReg::read(usart::DataMask());
+            return Regs::ControlReg1::set(usart::IdleLineIEnMask(true));
+        }
+
+        /// @brief Stops reception, data not yet published are dropped.
+        static StatusCode stop()
+        {
+            Regs::ControlReg1::clear(usart::IdleLineIEnMask(true));
+            Regs::ControlReg3::clear(usart::DmaRxEnableMask(true));
+            Rx::abort();
+            return Rx::clear_flags();
+        }
+
+        /// @brief Returns number of received bytes not yet published.
+        static uint16_t pending()
+        {
+            const uint16_t write_pos = static_cast<uint16_t>(ring_size - Rx::remaining());
+            return (write_pos >= read_pos) ? (write_pos - read_pos) : (ring_size - read_pos + write_pos);
+        }
+
+        /**
+         * @brief Publishes data on line idle, call it from the USART interrupt handler.
+         */
+        static void irq_handler()
+        {
+            if (!Regs::StatusReg::read(usart::IdleLineDetStatMask()).value)
+                return;
+
+            Regs::DataReg::read(usart::DataMask());
+            publish(usart::RxEvent::IdleLine);
+        }
+
+        /**
+         * @brief Publishes data on half and full ring, call it from the RX stream interrupt handler.
+         */
+        static void dma_irq_handler()
+        {
+            const uint32_t flags = Rx::flags();
+            Rx::clear_flags();
+
+            if (flags & (1U << static_cast<uint32_t>(dma::StatusFlag::TxComplete)))
+                publish(usart::RxEvent::Wrap);
+            else if (flags & (1U << static_cast<uint32_t>(dma::StatusFlag::HalfTx)))
+                publish(usart::RxEvent::HalfTransfer);
+        }
+};
+
+/**
+ * @brief Zero-copy USART transmitter chaining caller-owned buffers on DMA.
+ *
+ * Static class.
+ *
+ * Buffers are queued by reference in a fixed-size lock-free queue and sent one after another,
+ * the next one is started from the DMA transfer complete interrupt without any per-byte CPU work.
+ * After the last buffer the USART TC interrupt marks the line idle. `send()` may be called from
+ * thread context and from interrupts of any priority, a producer preempted in the middle of
+ * `send()` never blocks the others.
+ *
+ * `dma_irq_handler()` has to be called from the TX stream interrupt handler and `irq_handler()`
+ * from the USART interrupt handler. The USART has to be configured beforehand.
+ *
+ * @tparam Periph   USART peripheral.
+ * @tparam Capacity Queue size, power of two.
+ * @tparam TxStream DMA stream serving USART TX request.
+ */
+template<usart::Peripherals Periph, size_t Capacity = 16, dma::Streams TxStream = usart::DmaRoute<Periph>::tx_stream>
+class UsartDmaTx
+{
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+    private:
+        using Regs = UsartRegs<Periph>;
+        using Tx   = DmaRequestStream<usart::DmaRoute<Periph>::tx, TxStream>;
+
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence;
+            const uint8_t* data;
+            uint16_t len;
+            usart::TxCallback on_sent;
+        };
+
+        inline static Slot slots[Capacity]{};
+        inline static std::atomic<uint32_t> tail{0};
+        inline static uint32_t head{0};
+        inline static std::atomic<bool> active{false};
+        inline static std::atomic<bool> initialized{false};
+
+        static void init_slots()
+        {
+            // Sequence equal to the position marks a free slot (bounded MPMC queue by D. Vyukov)
+            for (uint32_t i = 0; i < Capacity; ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        static bool head_ready()
+        {
+            return slots[head & (Capacity - 1)].sequence.load(std::memory_order_acquire) == head + 1;
+        }
+
+        static void start_head()
+        {
+            const Slot& slot = slots[head & (Capacity - 1)];
+            const dma::StreamConfig config{
+                .direction = dma::TransferDirection::MemToPeriph,
+                .periph_size = dma::DataSize::Byte,
+                .mem_size = dma::DataSize::Byte,
+                .mem_incr = dma::AddrIncrementMode::AddrPtrIncr,
+                .priority = dma::PriorityLevel::Medium,
+                .tx_complete_irq = true,
+                .tx_error_irq = true
+            };
+
+            // Stale TC from the previous buffer would end the chain early
+            Regs::ControlReg1::clear(usart::TxCompleteIEnMask(true));
+            Regs::StatusReg::clear(usart::TxCompleteStatMask(true));
+            Tx::start(config, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(slot.data)), Regs::DataReg::get_addr(), slot.len);
+        }
+
+        static void kick()
+        {
+            bool idle = false;
+            if (head_ready() && active.compare_exchange_strong(idle, true, std::memory_order_acq_rel))
+            {
+                // Producer may have published between the check and the claim, check again as owner
+                if (head_ready())
+                    start_head();
+                else
+                    active.store(false, std::memory_order_release);
+            }
+        }
+
+    public:
+        UsartDmaTx() = delete;
+
+        /**
+         * @brief Prepares the queue and enables DMA requests of the transmitter, call it before `send()`.
+         */
+        static StatusCode init()
+        {
+            if (!initialized.exchange(true))
+                init_slots();
+
+            // DMA TX request stays enabled between buffers
+            return Regs::ControlReg3::set(usart::DmaTxEnableMask(true));
+        }
+
+        /**
+         * @brief Queues the buffer for transmission, starts it right away if the line is idle.
+         *
+         * @param data    Data to send, must stay valid and unchanged until `on_sent` is called.
+         * @param len     Number of bytes, at least 1.
+         * @param on_sent Optional, called from interrupt context when the buffer was read out.
+         * @return `StatusCode::Error` if the queue is full or the buffer is empty.
+         */
+        static StatusCode send(const uint8_t* data, uint16_t len, usart::TxCallback on_sent = nullptr)
+        {
+            if (data == nullptr || len == 0)
+                return StatusCode::Error;
+
+            uint32_t pos = tail.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &slots[pos & (Capacity - 1)];
+                const int32_t diff = static_cast<int32_t>(slot->sequence.load(std::memory_order_acquire) - pos);
+                if (diff == 0)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return StatusCode::Error;
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->data = data;
+            slot->len = len;
+            slot->on_sent = on_sent;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            kick();
+            return StatusCode::Ok;
+        }
+
+        /// @brief Returns true while buffers are queued or the last byte is still shifting out.
+        static bool is_busy()
+        {
+            return active.load(std::memory_order_acquire) || head_ready();
+        }
+
+        /**
+         * @brief Releases the sent buffer and chains the next one, call it from the TX stream interrupt handler.
+         */
+        static void dma_irq_handler()
+        {
+            const uint32_t flags = Tx::flags();
+            const bool error = flags & (1U << static_cast<uint32_t>(dma::StatusFlag::TxError));
+            if ((!error && !(flags & (1U << static_cast<uint32_t>(dma::StatusFlag::TxComplete)))) || !head_ready())
+                return;
+
+            Tx::clear_flags();
+            if (error)
+                Tx::abort();
+
+            Slot& done = slots[head & (Capacity - 1)];
+            const uint8_t* data = done.data;
+            const usart::TxCallback on_sent = done.on_sent;
+            done.sequence.store(head + Capacity, std::memory_order_release);
+            ++head;
+
+            if (on_sent)
+                on_sent(data, error ? StatusCode::Error : StatusCode::Ok);
+
+            if (head_ready())
+            {
+                start_head();
+            }
+            else
+            {
+                // Line becomes idle once the last byte left the shift register
+                Regs::ControlReg1::set(usart::TxCompleteIEnMask(true));
+            }
+        }
+
+        /**
+         * @brief Marks the line idle on transmission complete, call it from the USART interrupt handler.
+         */
+        static void irq_handler()
+        {
+            if (!Regs::ControlReg1::read(usart::TxCompleteIEnMask()).value || !Regs::StatusReg::read(usart::TxCompleteStatMask()).value)
+                return;
+
+            Regs::ControlReg1::clear(usart::TxCompleteIEnMask(true));
+            Regs::StatusReg::clear(usart::TxCompleteStatMask(true));
+            active.store(false, std::memory_order_release);
+            kick();
+        }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef _USARTIRQ_HPP_
+#define _USARTIRQ_HPP_
+
+#include "usart_regs.hpp"
+#include "spsc_ring.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdint.h>
+
+namespace usart
+{
+    /**
+     * @brief Receive error counters, each flag is counted once per received byte it was reported with.
+     */
+    struct ErrorCounters
+    {
+        uint32_t overrun;    ///< ORE, bytes were lost in the USART
+        uint32_t framing;    ///< FE
+        uint32_t noise;      ///< NF
+        uint32_t parity;     ///< PE
+        uint32_t rx_dropped; ///< Received bytes dropped because the RX ring was full
+    };
+};
+
+/**
+ * @brief Interrupt driven USART with lock-free RX and TX rings, for links without free DMA streams.
+ *
+ * Static class.
+ *
+ * The application is the producer of the TX ring and the consumer of the RX ring, the interrupt is
+ * the other side of both. Each interrupt entry moves bytes while the flags allow it, errors reported
+ * with received bytes are counted instead of lost. `irq_handler()` has to be called from the USART
+ * interrupt handler, the USART has to be configured with receiver and transmitter enabled beforehand.
+ *
+ * @tparam Periph USART peripheral.
+ * @tparam RxSize RX ring size, power of two.
+ * @tparam TxSize TX ring size, power of two.
+ */
+template<usart::Peripherals Periph, size_t RxSize = 256, size_t TxSize = 256>
+class UsartIrq
+{
+    private:
+        using Regs = UsartRegs<Periph>;
+
+        static constexpr uint32_t PE   = usart::ParityErrStatMask(true);
+        static constexpr uint32_t FE   = usart::FramingErrStatMask(true);
+        static constexpr uint32_t NF   = usart::NoiseDetStatMask(true);
+        static constexpr uint32_t ORE  = usart::OverrunErrStatMask(true);
+        static constexpr uint32_t RXNE = usart::RxNotEmptyStatMask(true);
+        static constexpr uint32_t TC   = usart::TxCompleteStatMask(true);
+        static constexpr uint32_t TXE  = usart::TxEmptyStatMask(true);
+
+        // Bounds work per entry, one byte frame time is far longer than this loop
+        static constexpr uint32_t MAX_ROUNDS = 4;
+
+        inline static SpscRing<uint8_t, RxSize> rx_ring{};
+        inline static SpscRing<uint8_t, TxSize> tx_ring{};
+        inline static usart::ErrorCounters counters{};
+        inline static std::atomic<bool> tx_idle{true};
+
+        static uint32_t status()
+        {
+            // Error flags and rc_w0 flags differ in access type, read them as one raw mask
+            return Regs::StatusReg::read(RegisterMask<usart::SR_Tag, reg::BitFieldAccessFlag::RW, 32, 0, uint32_t, true>{PE | FE | NF | ORE | RXNE | TC | TXE});
+        }
+
+    public:
+        UsartIrq() = delete;
+
+        /// @brief Enables receive interrupt, call it once after the USART was configured.
+        static StatusCode start()
+        {
+            return Regs::ControlReg1::set(usart::RxNotEmptyIEnMask(true));
+        }
+
+        /**
+         * @brief Queues data for transmission.
+         *
+         * @return Number of bytes queued, less than `len` if the TX ring is full.
+         */
+        static size_t write(const uint8_t* data, size_t len)
+        {
+            const size_t queued = tx_ring.push(data, len);
+            if (queued != 0)
+            {
+                tx_idle.store(false, std::memory_order_relaxed);
+                // Single bit-band store, safe against the interrupt clearing the bit
+                Regs::ControlReg1::set(usart::TxEmptyIEnMask(true));
+            }
+            return queued;
+        }
+
+        /**
+         * @brief Takes received data.
+         *
+         * @return Number of bytes copied to `out`.
+         */
+        static size_t read(uint8_t* out, size_t len)
+        {
+            return rx_ring.pop(out, len);
+        }
+
+        /// @brief Returns number of received bytes waiting in the RX ring.
+        static size_t available()
+        {
+            return rx_ring.size();
+        }
+
+        /// @brief Returns true once queued data left the shift register.
+        static bool is_tx_idle()
+        {
+            return tx_idle.load(std::memory_order_acquire) && tx_ring.empty();
+        }
+
+        /// @brief Returns snapshot of the error counters.
+        static usart::ErrorCounters errors()
+        {
+            return counters;
+        }
+
+        /**
+         * @brief Moves bytes between the USART and the rings, call it from the USART interrupt handler.
+         */
+        static void irq_handler()
+        {
+            bool tx_irq = Regs::ControlReg1::read(usart::TxEmptyIEnMask()).value;
+            const bool tc_irq = Regs::ControlReg1::read(usart::TxCompleteIEnMask()).value;
+
+            for (uint32_t round = 0; round < MAX_ROUNDS; ++round)
+            {
+                const uint32_t sr = status();
+                bool progress = false;
+
+                if (sr & (RXNE | ORE))
+                {
+                    // SR read followed by DR read also clears PE, FE, NF and ORE
+                    counters.parity   += (sr & PE)  ? 1U : 0U;
+                    counters.framing  += (sr & FE)  ? 1U : 0U;
+                    counters.noise    += (sr & NF)  ? 1U : 0U;
+                    counters.overrun  += (sr & ORE) ? 1U : 0U;
+
+                    const uint8_t byte = static_cast<uint8_t>(Regs::DataReg::read(usart::DataMask()).value);
+                    if (!rx_ring.push(byte))
+                        ++counters.rx_dropped;
+                    progress = true;
+                }
+
+                if (tx_irq && (sr & TXE))
+                {
+                    uint8_t byte;
+                    if (tx_ring.pop(byte))
+                    {
+                        Regs::DataReg::write(usart::DataMask(byte));
+                        progress = true;
+                    }
+                    else
+                    {
+                        tx_irq = false;
+                        Regs::ControlReg1::clear(usart::TxEmptyIEnMask(true));
+                        Regs::ControlReg1::set(usart::TxCompleteIEnMask(true));
+                        // Producer may have queued data between the pop and the TXEIE clear
+                        if (!tx_ring.empty())
+                            Regs::ControlReg1::set(usart::TxEmptyIEnMask(true));
+                    }
+                }
+                else if (tc_irq && (sr & TC))
+                {
+                    // Every TC entry has to remove its cause, otherwise it is taken again right away
+                    if (tx_ring.empty())
+                    {
+                        Regs::ControlReg1::clear(usart::TxCompleteIEnMask(true));
+                        tx_idle.store(true, std::memory_order_release);
+                    }
+                    else
+                    {
+                        // write() queued data but was interrupted before enabling TXEIE, take over the draining
+                        tx_irq = true;
+                        Regs::ControlReg1::set(usart::TxEmptyIEnMask(true));
+                        progress = true;
+                    }
+                }
+
+                if (!progress)
+                    break;
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef _USARTLOG_HPP_
+#define _USARTLOG_HPP_
+
+#include "usart_dma.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdint.h>
+
+namespace usart
+{
+    /**
+     * @brief What `UsartLog::write()` does when the ring is full.
+     */
+    enum class OverflowPolicy : uint8_t
+    {
+        Drop,      ///< Bytes that do not fit are dropped, older output is kept
+        Overwrite, ///< Backlog not yet handed to the transmitter is discarded in favor of new output
+        Block      ///< Caller waits for free space, never use it from interrupt context
+    };
+
+    /**
+     * @brief How the ring is drained into the USART.
+     */
+    enum class Drain : uint8_t
+    {
+        Dma,      ///< TX DMA, one transfer per contiguous part of the ring
+        Interrupt ///< TXE interrupt, one byte per interrupt
+    };
+};
+
+/**
+ * @brief Non-blocking buffered output sink, e.g. for `printf` retargeting.
+ *
+ * Static class.
+ *
+ * `write()` only copies into a lock-free single-producer single-consumer ring, the transmitter
+ * drains it in the background. With DMA the ring is sent in contiguous chunks directly from the
+ * buffer, bytes handed to DMA stay reserved until its transfer completes. Dropped bytes are counted.
+ *
+ * Single producer: `write()` must not be called from several contexts concurrently.
+ * With `Drain::Dma` call `dma_irq_handler()` from the TX stream interrupt handler, with
+ * `Drain::Interrupt` call `irq_handler()` from the USART interrupt handler.
+ * The USART has to be configured with the transmitter enabled beforehand.
+ *
+ * @tparam Periph   USART peripheral.
+ * @tparam Size     Ring size in bytes, power of two.
+ * @tparam Policy   Overflow policy.
+ * @tparam Mode     Drain mode.
+ * @tparam TxStream DMA stream serving USART TX request, used with `Drain::Dma`.
+ */
+template<usart::Peripherals Periph, size_t Size = 1024, usart::OverflowPolicy Policy = usart::OverflowPolicy::Drop,
+         usart::Drain Mode = usart::Drain::Dma, dma::Streams TxStream = usart::DmaRoute<Periph>::tx_stream>
+class UsartLog
+{
+    static_assert(Size > 1 && Size <= 0x8000U && (Size & (Size - 1)) == 0, "Ring size must be a power of two up to 32 KiB");
+
+    private:
+        using Regs = UsartRegs<Periph>;
+        using Tx   = DmaRequestStream<usart::DmaRoute<Periph>::tx, TxStream>;
+
+        inline static uint8_t ring[Size]{};
+        inline static std::atomic<uint32_t> tail{0};      ///< End of written data, owned by the producer
+        inline static std::atomic<uint32_t> read{0};      ///< Start of data not yet handed to the transmitter
+        inline static std::atomic<uint32_t> released{0};  ///< Start of data still read by the transmitter
+        inline static std::atomic<bool> active{false};
+        inline static std::atomic<bool> writing{false};
+        inline static std::atomic<uint32_t> dropped_bytes{0};
+        inline static std::atomic<uint32_t> overflow_events{0};
+
+        static void start_chunk()
+        {
+            const uint32_t from = read.load(std::memory_order_relaxed);
+            const uint32_t offset = from & (Size - 1);
+            uint32_t len = tail.load(std::memory_order_acquire) - from;
+            if (len > Size - offset)
+                len = Size - offset;
+
+            read.store(from + len, std::memory_order_release);
+
+            const dma::StreamConfig config{
+                .direction = dma::TransferDirection::MemToPeriph,
+                .periph_size = dma::DataSize::Byte,
+                .mem_size = dma::DataSize::Byte,
+                .mem_incr = dma::AddrIncrementMode::AddrPtrIncr,
+                .priority = dma::PriorityLevel::Low,
+                .tx_complete_irq = true,
+                .tx_error_irq = true
+            };
+            Tx::start(config, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ring + offset)), Regs::DataReg::get_addr(), static_cast<uint16_t>(len));
+        }
+
+        static bool has_pending()
+        {
+            return tail.load(std::memory_order_acquire) != read.load(std::memory_order_relaxed);
+        }
+
+        static void kick()
+        {
+            bool idle = false;
+            if (!has_pending() || !active.compare_exchange_strong(idle, true, std::memory_order_acq_rel))
+                return;
+
+            if constexpr (Mode == usart::Drain::Dma)
+            {
+                Regs::ControlReg3::set(usart::DmaTxEnableMask(true));
+                start_chunk();
+            }
+            else
+            {
+                Regs::ControlReg1::set(usart::TxEmptyIEnMask(true));
+            }
+        }
+
+        static uint32_t free_space()
+        {
+            return Size - (tail.load(std::memory_order_relaxed) - released.load(std::memory_order_acquire));
+        }
+
+        static void copy_in(const uint8_t* data, uint32_t len)
+        {
+            const uint32_t at = tail.load(std::memory_order_relaxed);
+            const uint32_t offset = at & (Size - 1);
+            const uint32_t first = (len < Size - offset) ? len : (Size - offset);
+            std::memcpy(ring + offset, data, first);
+            std::memcpy(ring, data + first, len - first);
+            tail.store(at + len, std::memory_order_release);
+        }
+
+        static void count_dropped(uint32_t len)
+        {
+            dropped_bytes.fetch_add(len, std::memory_order_relaxed);
+            overflow_events.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        UsartLog() = delete;
+
+        /**
+         * @brief Copies data into the ring and starts draining it.
+         *
+         * @param data Data to send.
+         * @param len  Number of bytes.
+         * @return Number of bytes consumed, dropped bytes included, so callers never retry.
+         */
+        static size_t write(const void* data, size_t len)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            size_t left = len;
+
+            if constexpr (Policy == usart::OverflowPolicy::Block)
+            {
+                while (left != 0)
+                {
+                    const uint32_t space = free_space();
+                    const uint32_t chunk = (left < space) ? static_cast<uint32_t>(left) : space;
+                    if (chunk != 0)
+                    {
+                        copy_in(bytes, chunk);
+                        bytes += chunk;
+                        left -= chunk;
+                    }
+                    kick();
+                }
+                return len;
+            }
+            else
+            {
+                if constexpr (Policy == usart::OverflowPolicy::Overwrite)
+                {
+                    // Keeps the drain from taking new data while the backlog may be rewound
+                    writing.store(true, std::memory_order_seq_cst);
+                }
+
+                if (Policy == usart::OverflowPolicy::Overwrite && left > free_space())
+                {
+                    const uint32_t from = read.load(std::memory_order_acquire);
+                    const uint32_t backlog = tail.load(std::memory_order_relaxed) - from;
+                    if (backlog != 0)
+                    {
+                        count_dropped(backlog);
+                        tail.store(from, std::memory_order_release);
+                    }
+                }
+
+                const uint32_t space = free_space();
+                if (left > space)
+                {
+                    // Keep the newest bytes of the message when overwriting, the oldest otherwise
+                    const uint32_t excess = static_cast<uint32_t>(left - space);
+                    count_dropped(excess);
+                    if (Policy == usart::OverflowPolicy::Overwrite)
+                        bytes += excess;
+                    left = space;
+                }
+
+                copy_in(bytes, static_cast<uint32_t>(left));
+                if constexpr (Policy == usart::OverflowPolicy::Overwrite)
+                    writing.store(false, std::memory_order_seq_cst);
+                kick();
+                return len;
+            }
+        }
+
+        /// @brief Returns number of bytes dropped on overflow since start.
+        static uint32_t dropped()
+        {
+            return dropped_bytes.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Returns number of `write()` calls that dropped data since start.
+        static uint32_t overflows()
+        {
+            return overflow_events.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Returns number of bytes waiting in the ring, including bytes in flight.
+        static size_t pending()
+        {
+            return tail.load(std::memory_order_acquire) - released.load(std::memory_order_acquire);
+        }
+
+        /// @brief Blocks until everything written was handed to the USART.
+        static void flush()
+        {
+            while (pending() != 0)
+                kick();
+        }
+
+        /**
+         * @brief Releases the sent chunk and starts the next one, call it from the TX stream interrupt handler.
+         */
+        static void dma_irq_handler()
+        {
+            static_assert(Mode == usart::Drain::Dma, "Interrupt drained instance is progressed by irq_handler()");
+            const uint32_t flags = Tx::flags();
+            if (!(flags & ((1U << static_cast<uint32_t>(dma::StatusFlag::TxComplete)) | (1U << static_cast<uint32_t>(dma::StatusFlag::TxError)))))
+                return;
+
+            Tx::clear_flags();
+            released.store(read.load(std::memory_order_relaxed), std::memory_order_release);
+
+            if (!writing.load(std::memory_order_acquire) && has_pending())
+                start_chunk();
+            else
+                active.store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief Sends the next byte on TXE, call it from the USART interrupt handler.
+         */
+        static void irq_handler()
+        {
+            static_assert(Mode == usart::Drain::Interrupt, "DMA drained instance is progressed by dma_irq_handler()");
+            if (!Regs::ControlReg1::read(usart::TxEmptyIEnMask()).value || !Regs::StatusReg::read(usart::TxEmptyStatMask()).value)
+                return;
+
+            if (writing.load(std::memory_order_acquire) || !has_pending())
+            {
+                Regs::ControlReg1::clear(usart::TxEmptyIEnMask(true));
+                active.store(false, std::memory_order_release);
+                return;
+            }
+
+            const uint32_t from = read.load(std::memory_order_relaxed);
+            Regs::DataReg::write(usart::DataMask(ring[from & (Size - 1)]));
+            read.store(from + 1, std::memory_order_relaxed);
+            released.store(from + 1, std::memory_order_release);
+        }
+};
+
+#endif
@@ -45,11 +45,11 @@ namespace usart
     using NoiseDetStatMask    = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 2, bool>;
     using OverrunErrStatMask  = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 3, bool>;
     using IdleLineDetStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 4, bool>;
-    using RxNotEmptyStatMask  = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 5, bool>;
-    using TxCompleteStatMask  = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 6, bool>;
+    using RxNotEmptyStatMask  = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RC_W0, 1, 5, bool>;
+    using TxCompleteStatMask  = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RC_W0, 1, 6, bool>;
     using TxEmptyStatMask     = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 7, bool>;
-    using LinBreakDetStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 8, bool>;
-    using ClearToSendStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RW, 1, 9, bool>;
+    using LinBreakDetStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RC_W0, 1, 8, bool>;
+    using ClearToSendStatMask = RegisterMask<SR_Tag, reg::BitFieldAccessFlag::RC_W0, 1, 9, bool>;
 
     using DataMask             = RegisterMask<DR_Tag,  reg::BitFieldAccessFlag::RW, 8, 0,  uint8_t>;
     using BaudRateFractionMask = RegisterMask<BRR_Tag, reg::BitFieldAccessFlag::RW, 4, 0,  uint8_t>;
@@ -59,6 +59,7 @@ namespace usart
     using ReceiverWakeUpMask   = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 1,  ReceiverWakeUp>;
     using RxEnableMask         = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 2,  bool>;
     using TxEnableMask         = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 3,  bool>;
+    using IdleLineIEnMask      = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 4,  bool>;
     using RxNotEmptyIEnMask    = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 5,  bool>;
     using TxCompleteIEnMask    = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 6,  bool>;
     using TxEmptyIEnMask       = RegisterMask<CR1_Tag, reg::BitFieldAccessFlag::RW, 1, 7,  bool>;
@@ -68,6 +69,102 @@ namespace usart
     using ErrorIEnableMask     = RegisterMask<CR3_Tag, reg::BitFieldAccessFlag::RW, 1, 0, bool>;
     using DmaRxEnableMask      = RegisterMask<CR3_Tag, reg::BitFieldAccessFlag::RW, 1, 6, bool>;
     using DmaTxEnableMask      = RegisterMask<CR3_Tag, reg::BitFieldAccessFlag::RW, 1, 7, bool>;
+
+    using BaudRateMask         = RegisterMask<BRR_Tag, reg::BitFieldAccessFlag::RW, 16, 0, uint16_t>;
+
+    /**
+     * @brief Oversampling selection for `baud()`.
+     */
+    enum class OversamplingSel : uint8_t
+    {
+        Auto = 0U, ///< Oversampling by 16 when it meets the error bound, by 8 otherwise
+        Over_16,
+        Over_8
+    };
+
+    /**
+     * @brief Baud rate register value together with the oversampling it was computed for.
+     */
+    struct BaudRate
+    {
+        uint16_t brr;              ///< BRR value (mantissa and fraction)
+        Oversampling oversampling; ///< OVER8 setting the BRR value is valid for
+        uint32_t actual;           ///< Resulting baud rate
+        uint32_t error_ppm;        ///< Deviation from the requested rate in ppm
+
+        /// @brief Returns mask to write into BRR.
+        constexpr BaudRateMask brr_mask() const
+        {
+            return BaudRateMask(brr);
+        }
+
+        /// @brief Returns mask to write into CR1 OVER8 field.
+        constexpr OversamplingModeMask oversampling_mask() const
+        {
+            return OversamplingModeMask(oversampling);
+        }
+    };
+
+    /**
+     * @brief Computes BRR for the clock and baud rate, rounded to the nearest divider.
+     *
+     * Returns `brr == 0` if the rate is out of reach of the divider.
+     */
+    constexpr BaudRate compute_baud(uint32_t pclk_hz, uint32_t baud, Oversampling oversampling)
+    {
+        if (baud == 0)
+            return {0, oversampling, 0, 0};
+
+        // pclk / baud is USARTDIV in 1/16 (OVER8 = 0) or 1/8 (OVER8 = 1) units, only the fraction field differs (4 or 3 bits)
+        const uint32_t div = (pclk_hz + baud / 2U) / baud;
+        const uint32_t frac_bits = (oversampling == Oversampling::Over_16) ? 4U : 3U;
+        const uint32_t mantissa = div >> frac_bits;
+        if (mantissa == 0 || mantissa > 0xFFFU)
+            return {0, oversampling, 0, 0};
+
+        const uint32_t actual = pclk_hz / div;
+        const uint32_t delta = (actual > baud) ? (actual - baud) : (baud - actual);
+        const uint16_t brr = static_cast<uint16_t>((mantissa << 4) | (div & ((1U << frac_bits) - 1U)));
+
+        return {brr, oversampling, actual, static_cast<uint32_t>(static_cast<uint64_t>(delta) * 1000000U / baud)};
+    }
+
+    /**
+     * @brief Computes BRR at compile time and checks the rate error.
+     *
+     * `Regs::BaudRateReg::write(cfg.brr_mask())` and `Regs::ControlReg1::modify_fields(cfg.oversampling_mask())`
+     * apply the result, OVER8 has to be written as well when `Auto` may select it.
+     *
+     * @tparam PclkHz        Clock of the APB bus the USART sits on.
+     * @tparam Baud          Requested baud rate.
+     * @tparam Sel           Oversampling, `Auto` picks by 8 only when by 16 cannot meet the error bound.
+     * @tparam MaxErrorPpm   Allowed deviation from the requested rate in ppm.
+     * @return `BaudRate` with the BRR value and oversampling.
+     */
+    template<uint32_t PclkHz, uint32_t Baud, OversamplingSel Sel = OversamplingSel::Auto, uint32_t MaxErrorPpm = 10000U>
+    constexpr BaudRate baud()
+    {
+        constexpr BaudRate over16 = compute_baud(PclkHz, Baud, Oversampling::Over_16);
+        constexpr BaudRate over8  = compute_baud(PclkHz, Baud, Oversampling::Over_8);
+        constexpr bool over16_ok  = (over16.brr != 0) && (over16.error_ppm <= MaxErrorPpm);
+        constexpr bool over8_ok   = (over8.brr != 0) && (over8.error_ppm <= MaxErrorPpm);
+
+        if constexpr (Sel == OversamplingSel::Over_16)
+        {
+            static_assert(over16_ok, "Baud rate not reachable within error bound with oversampling by 16");
+            return over16;
+        }
+        else if constexpr (Sel == OversamplingSel::Over_8)
+        {
+            static_assert(over8_ok, "Baud rate not reachable within error bound with oversampling by 8");
+            return over8;
+        }
+        else
+        {
+            static_assert(over16_ok || over8_ok, "Baud rate not reachable within error bound");
+            return over16_ok ? over16 : over8;
+        }
+    }
 };
 
 /**
@@ -93,4 +190,13 @@ class UsartRegs
         using ControlReg3 = Register<usart::CR3_Tag, BASE_ADDR + 0x14>;
 };
 
+static_assert(usart::baud<16000000U, 115200U>().brr == 0x8BU, "USART BRR computation mismatch");
+static_assert(usart::baud<96000000U, 12000000U>().oversampling == usart::Oversampling::Over_8, "USART OVER8 selection mismatch");
+static_assert(usart::baud<96000000U, 12000000U>().brr == 0x10U, "USART OVER8 BRR computation mismatch");
+
+// Bit-band alias of every USART base, values as computed by the reference manual formula
+static_assert(UsartRegs<usart::Peripherals::Usart1>::StatusReg::bit_band_addr<0>() == 0x42220000UL, "USART1 bit-band alias mismatch");
+static_assert(UsartRegs<usart::Peripherals::Usart2>::StatusReg::bit_band_addr<0>() == 0x42088000UL, "USART2 bit-band alias mismatch");
+static_assert(UsartRegs<usart::Peripherals::Usart6>::StatusReg::bit_band_addr<0>() == 0x42228000UL, "USART6 bit-band alias mismatch");
+
 #endif
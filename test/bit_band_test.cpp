@@ -0,0 +1,60 @@
+// Included first on purpose, the simulator has to build without register_base.hpp
+#include "register_sim.hpp"
+
+#include "check.hpp"
+#include "rcc_regs.hpp"
+#include "usart_regs.hpp"
+
+// set() and clear() of single bit fields go through the bit-band alias, rc_w0 flags are written with the inverted mask
+int main()
+{
+    auto& file = reg::sim::RegisterFile::instance();
+    using Ahb1 = ResetClockCtrlRegs::Ahb1EnableReg;
+    const uint32_t addr = Ahb1::get_addr();
+
+    // Alias math: 0x42000000 + (0x40023830 - 0x40000000) * 32 + bit * 4
+    CHECK(reg::bit_band_alias(addr, 0) == 0x42470600U);
+    CHECK(reg::bit_band_alias(addr, 22) == 0x42470658U);
+    CHECK(reg::bit_band_target_addr(0x42470658U) == addr);
+    CHECK(reg::bit_band_target_bit(0x42470658U) == 22);
+    CHECK(!reg::is_bit_band_alias(addr));
+
+    // set(): one store to the alias word, other bits of the register preserved
+    file.reset();
+    file.poke(addr, 0x00400080U);
+    Ahb1::set(rcc::GpioAEnableMask(true));
+    CHECK(file.writes() == 1);
+    CHECK(file.writes(0x42470600U) == 1);
+    CHECK(file.writes(addr) == 0);
+    CHECK(file.log().size() == 1 && file.log()[0].value == 1U);
+    CHECK(file.peek(addr) == 0x00400081U);
+
+    // clear(): one store of zero to the alias word
+    file.clear_log();
+    Ahb1::clear(rcc::DMA2EnableMask(true));
+    Ahb1::clear(rcc::GpioAEnableMask(true));
+    CHECK(file.writes() == 2);
+    CHECK(file.writes(0x42470658U) == 1);
+    CHECK(file.writes(0x42470600U) == 1);
+    CHECK(file.peek(addr) == 0x00000080U);
+
+    // Bit-band read returns the bit only
+    file.clear_log();
+    CHECK(file.load(reg::bit_band_alias(addr, 7)) == 1U);
+    CHECK(file.load(reg::bit_band_alias(addr, 6)) == 0U);
+
+    // rc_w0 clear: single write of the inverted mask, no read, flags raised meanwhile survive
+    using Sr = UsartRegs<usart::Peripherals::Usart2>::StatusReg;
+    const uint32_t sr = Sr::get_addr();
+    file.reset();
+    file.poke(sr, 0x000000F0U);
+    file.on_write(sr, [](uint32_t stored, uint32_t written) { return stored & (written | ~0x360U); });
+    Sr::clear(usart::TxCompleteStatMask(true));
+    CHECK(file.reads() == 0);
+    CHECK(file.writes() == 1);
+    CHECK(file.writes(sr) == 1);
+    CHECK(file.log()[0].value == ~0x40U);
+    CHECK(file.peek(sr) == 0x000000B0U);
+
+    return check_result();
+}
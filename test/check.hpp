@@ -0,0 +1,29 @@
+#ifndef _CHECK_HPP_
+#define _CHECK_HPP_
+
+#include <cstdio>
+
+/**
+ * @brief Minimal host test helpers, a failed check is reported and the test keeps running.
+ */
+inline int check_failures = 0;
+
+#define CHECK(cond)                                                                      \
+    do                                                                                   \
+    {                                                                                    \
+        if (!(cond))                                                                     \
+        {                                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++check_failures;                                                            \
+        }                                                                                \
+    } while (0)
+
+/// @brief Test exit code, non-zero if any check failed.
+inline int check_result()
+{
+    if (check_failures != 0)
+        std::fprintf(stderr, "%d check(s) failed\n", check_failures);
+    return check_failures != 0;
+}
+
+#endif
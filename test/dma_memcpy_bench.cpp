@@ -0,0 +1,195 @@
+#include "check.hpp"
+#include "dma_memcpy.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+// Simulated DMA2 stream 0 runs DmaMemcpy against a CPU byte loop. Built without PIE,
+// so buffer addresses fit SxPAR/SxM0AR and the model can dereference them directly.
+namespace
+{
+    using Memcpy = DmaMemcpy<dma::Streams::Stream_0, true>;
+    using Dma2 = DmaRegs<dma::Peripherals::Dma_2>;
+
+    constexpr uint32_t EN    = 1U << 0;
+    constexpr uint32_t PINC  = 1U << 9;
+    constexpr uint32_t TEIF0 = 1U << 3;
+    constexpr uint32_t TCIF0 = 1U << 5;
+
+    struct Chunk
+    {
+        uint32_t src;
+        uint32_t dst;
+        uint32_t items;
+        uint32_t size;
+        bool mem_burst;
+        bool periph_burst;
+    };
+
+    struct DmaModel
+    {
+        Chunk chunks[16]{};
+        uint32_t chunk_count{};
+        uint32_t bus_beats{};   ///< AHB data phases, one read and one write per item
+        uint32_t bus_grants{};  ///< Arbitrations, one per single transfer or burst
+        bool fail_next{};
+
+        void reset()
+        {
+            *this = DmaModel{};
+        }
+    };
+
+    DmaModel model;
+
+    uint8_t* host_ptr(uint32_t addr)
+    {
+        return reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(addr));
+    }
+
+    void attach_model()
+    {
+        auto& file = reg::sim::RegisterFile::instance();
+        file.reset();
+
+        const uint32_t lisr = Dma2::LowIStatReg::get_addr();
+        const uint32_t cr   = Dma2::ConfigReg<dma::Streams::Stream_0>::get_addr();
+        const uint32_t ndtr = Dma2::NumOfDataReg<dma::Streams::Stream_0>::get_addr();
+        const uint32_t par  = Dma2::PeriphAddrReg<dma::Streams::Stream_0>::get_addr();
+        const uint32_t m0ar = Dma2::Mem0AddrReg<dma::Streams::Stream_0>::get_addr();
+
+        file.on_write(Dma2::LowIClearReg::get_addr(), [&file, lisr](uint32_t, uint32_t written) {
+            file.poke(lisr, file.peek(lisr) & ~written);
+            return 0U;
+        });
+
+        // Stream runs the whole transfer when enabled and stops itself, as hardware does at NDTR == 0
+        file.on_write(cr, [&file, lisr, ndtr, par, m0ar](uint32_t, uint32_t value) {
+            if (!(value & EN))
+                return value;
+
+            if (model.fail_next)
+            {
+                model.fail_next = false;
+                file.poke(lisr, file.peek(lisr) | TEIF0);
+                return value & ~EN;
+            }
+
+            const uint32_t size = 1U << ((value >> 11) & 3U);
+            const uint32_t items = file.peek(ndtr);
+            const bool src_incr = value & PINC;
+            const bool mem_burst = ((value >> 23) & 3U) != 0;
+            const bool periph_burst = ((value >> 21) & 3U) != 0;
+            const uint32_t src = file.peek(par);
+            const uint32_t dst = file.peek(m0ar);
+
+            for (uint32_t i = 0; i < items; ++i)
+                std::memcpy(host_ptr(dst + i * size), host_ptr(src + (src_incr ? i * size : 0U)), size);
+
+            if (model.chunk_count < 16)
+                model.chunks[model.chunk_count] = {src, dst, items, size, mem_burst, periph_burst};
+            ++model.chunk_count;
+            model.bus_beats += 2 * items;
+            model.bus_grants += (periph_burst ? items / 4 : items) + (mem_burst ? items / 4 : items);
+
+            file.poke(ndtr, 0);
+            file.poke(lisr, file.peek(lisr) | TCIF0);
+            return value & ~EN;
+        });
+    }
+
+    // Reference the benchmark compares against, volatile keeps the compiler from turning it into memcpy
+    void byte_loop(volatile uint8_t* dst, const volatile uint8_t* src, size_t len)
+    {
+        while (len--)
+            *dst++ = *src++;
+    }
+
+    alignas(16) uint8_t src_buf[320 * 1024];
+    alignas(16) uint8_t dst_buf[320 * 1024];
+    alignas(16) uint8_t ref_buf[320 * 1024];
+
+    void run_copy(const char* name, uint32_t dst_off, uint32_t src_off, uint32_t len)
+    {
+        auto& file = reg::sim::RegisterFile::instance();
+        for (uint32_t i = 0; i < sizeof(src_buf); ++i)
+            src_buf[i] = static_cast<uint8_t>(i * 7U + 3U);
+        std::memset(dst_buf, 0, sizeof(dst_buf));
+        std::memset(ref_buf, 0, sizeof(ref_buf));
+
+        model.reset();
+        file.clear_log();
+        const StatusCode status = Memcpy::copy(dst_buf + dst_off, src_buf + src_off, len).wait();
+        const size_t driver_accesses = file.log().size();
+        byte_loop(ref_buf + dst_off, src_buf + src_off, len);
+
+        CHECK(status == StatusCode::Ok);
+        CHECK(std::memcmp(dst_buf, ref_buf, sizeof(dst_buf)) == 0);
+
+        // Every chunk fits SxNDTR, bursts only on aligned whole-burst chunks
+        uint32_t items = 0;
+        for (uint32_t i = 0; i < model.chunk_count && i < 16; ++i)
+        {
+            const Chunk& chunk = model.chunks[i];
+            const uint32_t burst_bytes = 4U * chunk.size;
+            items += chunk.items;
+            CHECK(chunk.items != 0 && chunk.items <= 0xFFFFU);
+            if (chunk.mem_burst)
+            {
+                CHECK(chunk.items % 4U == 0);
+                CHECK(chunk.dst % burst_bytes == 0);
+            }
+            if (chunk.periph_burst)
+                CHECK(chunk.src % burst_bytes == 0);
+        }
+        CHECK(model.chunk_count <= 16);
+        CHECK(model.chunk_count == 0 || items * model.chunks[0].size == len);
+
+        std::printf("%-24s %8u B  %2u chunk(s)  CPU loop %8u accesses | DMA driver %4zu register accesses, %8u bus beats, %8u grants\n",
+                    name, len, model.chunk_count, 2U * len, driver_accesses, model.bus_beats, model.bus_grants);
+    }
+}
+
+int main()
+{
+    CHECK(reinterpret_cast<uintptr_t>(dst_buf + sizeof(dst_buf)) <= 0xFFFFFFFFU);
+    attach_model();
+
+    run_copy("word, aligned", 0, 0, 4096);
+    run_copy("word, chunked", 0, 0, 300000);
+    run_copy("byte, odd length", 0, 0, 300001);
+    run_copy("half-word, unaligned", 2, 6, 1000);
+    run_copy("byte, unaligned", 1, 0, 257);
+    run_copy("empty", 0, 0, 0);
+    CHECK(model.chunk_count == 0);
+
+    // Chunk split: 300000 B of words is 75000 items, 65532 in bursts then 9468
+    run_copy("word, split check", 0, 0, 300000);
+    CHECK(model.chunk_count == 2);
+    CHECK(model.chunks[0].items == 0xFFFCU && model.chunks[0].mem_burst);
+    CHECK(model.chunks[1].items == 75000U - 0xFFFCU && model.chunks[1].mem_burst);
+
+    // Odd byte count ends with a single transfer chunk below the burst length
+    run_copy("byte, tail check", 0, 0, 13);
+    CHECK(model.chunk_count == 2);
+    CHECK(model.chunks[0].items == 12 && model.chunks[0].mem_burst);
+    CHECK(model.chunks[1].items == 1 && !model.chunks[1].mem_burst);
+
+    // Fill: fixed source, memory side still bursts
+    model.reset();
+    std::memset(dst_buf, 0, sizeof(dst_buf));
+    CHECK(Memcpy::fill(dst_buf, 0xA5, 4096).wait() == StatusCode::Ok);
+    CHECK(dst_buf[0] == 0xA5 && dst_buf[4095] == 0xA5 && dst_buf[4096] == 0);
+    CHECK(model.chunk_count == 1 && model.chunks[0].mem_burst && !model.chunks[0].periph_burst);
+
+    // Each handle reports its own result
+    model.reset();
+    model.fail_next = true;
+    const auto failed = Memcpy::copy(dst_buf, src_buf, 64);
+    CHECK(failed.wait() == StatusCode::Error);
+    const auto passed = Memcpy::copy(dst_buf, src_buf, 64);
+    CHECK(passed.wait() == StatusCode::Ok);
+    CHECK(failed.status() == StatusCode::Error);
+
+    return check_result();
+}
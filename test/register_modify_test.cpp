@@ -0,0 +1,38 @@
+#include "check.hpp"
+#include "rcc_regs.hpp"
+
+// modify(), modify_fields() and batch().commit() must cost exactly one read and one write
+int main()
+{
+    auto& file = reg::sim::RegisterFile::instance();
+    using Pll = ResetClockCtrlRegs::PllConfigReg;
+    const uint32_t addr = Pll::get_addr();
+
+    // modify(): clear and set in one access
+    file.reset();
+    file.poke(addr, 0x24003010U);
+    Pll::modify(rcc::PllMMask() | rcc::PllNMask(), rcc::PllMMask(4) | rcc::PllNMask(192));
+    CHECK(file.reads(addr) == 1);
+    CHECK(file.writes(addr) == 1);
+    CHECK(file.reads() == 1 && file.writes() == 1);
+    CHECK(file.peek(addr) == ((0x24003010U & ~0x7FFFU) | 4U | (192U << 6)));
+
+    // modify_fields(): every field cleared over its width and written once
+    file.reset();
+    file.poke(addr, 0xFFFFFFFFU);
+    Pll::modify_fields(rcc::PllMMask(8), rcc::PllNMask(336), rcc::PllPMask(rcc::PllP::Div_4), rcc::PllQMask(7));
+    CHECK(file.reads() == 1);
+    CHECK(file.writes() == 1);
+    CHECK(file.peek(addr) == ((0xFFFFFFFFU & ~(0x3FU | (0x1FFU << 6) | (0x3U << 16) | (0xFU << 24))) | 8U | (336U << 6) | (1U << 16) | (7U << 24)));
+
+    // batch(): gathering fields does not touch the register, commit does it once
+    file.reset();
+    auto transaction = Pll::batch(rcc::PllMMask(25)).with(rcc::PllNMask(400)).with(rcc::PllSrcMask(rcc::PllSource::Hse));
+    CHECK(file.log().empty());
+    transaction.commit();
+    CHECK(file.reads() == 1);
+    CHECK(file.writes() == 1);
+    CHECK(file.peek(addr) == (25U | (400U << 6) | (1U << 22)));
+
+    return check_result();
+}
@@ -0,0 +1,90 @@
+#include "check.hpp"
+#include "spsc_ring.hpp"
+
+#include <cstdint>
+#include <thread>
+
+// One producer and one consumer thread hammer a small ring with single and bulk operations,
+// every element has to arrive exactly once, in order and not torn
+namespace
+{
+    struct Item
+    {
+        uint32_t seq;
+        uint32_t check;  ///< ~seq, a torn copy breaks the pair
+    };
+
+    constexpr uint32_t ITEMS = 200000;
+    constexpr size_t BULK = 5;
+
+    SpscRing<Item, 16> ring;
+
+    void producer()
+    {
+        uint32_t next = 0;
+        while (next < ITEMS)
+        {
+            size_t pushed = 0;
+            if (next % 3 == 0)
+            {
+                Item batch[BULK];
+                size_t count = 0;
+                for (; count < BULK && next + count < ITEMS; ++count)
+                    batch[count] = {static_cast<uint32_t>(next + count), ~static_cast<uint32_t>(next + count)};
+                pushed = ring.push(batch, count);
+            }
+            else if (ring.push({next, ~next}))
+            {
+                pushed = 1;
+            }
+
+            next += static_cast<uint32_t>(pushed);
+            // Single core hosts need the consumer to run to make room
+            if (pushed == 0)
+                std::this_thread::yield();
+        }
+    }
+
+    uint32_t consumer()
+    {
+        uint32_t expected = 0;
+        uint32_t errors = 0;
+        while (expected < ITEMS)
+        {
+            Item batch[BULK];
+            size_t count = 0;
+            if (expected % 2 == 0)
+                count = ring.pop(batch, BULK);
+            else if (ring.pop(batch[0]))
+                count = 1;
+
+            if (count == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < count; ++i, ++expected)
+            {
+                if (batch[i].seq != expected || batch[i].check != ~expected)
+                    ++errors;
+            }
+        }
+        return errors;
+    }
+}
+
+int main()
+{
+    uint32_t errors = 0;
+    std::thread consumer_thread([&errors] { errors = consumer(); });
+    std::thread producer_thread(producer);
+    producer_thread.join();
+    consumer_thread.join();
+
+    CHECK(errors == 0);
+    CHECK(ring.empty());
+    CHECK(ring.size() == 0);
+
+    return check_result();
+}
@@ -0,0 +1,41 @@
+#include "check.hpp"
+#include "usart_irq.hpp"
+
+// TC taken while write() queued data but TXEIE is still off must not leave TC as a pending cause
+int main()
+{
+    auto& file = reg::sim::RegisterFile::instance();
+    using Irq  = UsartIrq<usart::Peripherals::Usart2, 16, 16>;
+    using Regs = UsartRegs<usart::Peripherals::Usart2>;
+    const uint32_t sr  = Regs::StatusReg::get_addr();
+    const uint32_t dr  = Regs::DataReg::get_addr();
+    const uint32_t cr1 = Regs::ControlReg1::get_addr();
+    const uint32_t TXEIE = usart::TxEmptyIEnMask(true);
+    const uint32_t TCIE  = usart::TxCompleteIEnMask(true);
+
+    // Idle link: TXE and TC set, TCIE armed
+    file.reset();
+    file.poke(sr, static_cast<uint32_t>(usart::TxEmptyStatMask(true)) | static_cast<uint32_t>(usart::TxCompleteStatMask(true)));
+    file.poke(cr1, TCIE);
+
+    // write() interrupted right after the push, before its TXEIE store
+    const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    CHECK(Irq::write(data, sizeof(data)) == sizeof(data));
+    file.poke(cr1, file.peek(cr1) & ~TXEIE);
+    file.clear_log();
+
+    Irq::irq_handler();
+    const uint32_t control = file.peek(cr1);
+    CHECK((control & TXEIE) != 0 || (control & TCIE) == 0);
+    CHECK(file.writes(dr) >= 1);
+    CHECK(!Irq::is_tx_idle());
+
+    // Following entries drain the ring, then TC closes the transfer
+    for (int entry = 0; entry < 8 && !Irq::is_tx_idle(); ++entry)
+        Irq::irq_handler();
+    CHECK(Irq::is_tx_idle());
+    CHECK(file.writes(dr) == sizeof(data));
+    CHECK((file.peek(cr1) & (TXEIE | TCIE)) == 0);
+
+    return check_result();
+}
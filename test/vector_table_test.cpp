@@ -0,0 +1,29 @@
+#include "check.hpp"
+#include "core_regs.hpp"
+
+// relocate() and address() have to agree on the table address, not on the TBLOFF field value
+int main()
+{
+    auto& file = reg::sim::RegisterFile::instance();
+    const uint32_t vtor = SystemCtrlBlockRegs::VectorTableOffsetReg::get_addr();
+
+    const uint32_t tables[] = {0x20000000U, 0x20001E00U, 0x08000000U, 0x00000000U};
+    for (const uint32_t addr : tables)
+    {
+        file.reset();
+        const uint32_t* table = reinterpret_cast<const uint32_t*>(static_cast<uintptr_t>(addr));
+        CHECK(VectorTable::relocate(table) == StatusCode::Ok);
+        CHECK(file.peek(vtor) == addr);
+        CHECK(VectorTable::address() == addr);
+        CHECK(reinterpret_cast<const uint32_t*>(static_cast<uintptr_t>(VectorTable::address())) == table);
+    }
+
+    // Misaligned table is rejected, VTOR untouched
+    file.reset();
+    file.poke(vtor, 0x20000000U);
+    CHECK(VectorTable::relocate(reinterpret_cast<const uint32_t*>(static_cast<uintptr_t>(0x20000100U))) == StatusCode::Error);
+    CHECK(file.writes() == 0);
+    CHECK(VectorTable::address() == 0x20000000U);
+
+    return check_result();
+}